@@ -17,6 +17,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "quantum.h"
+#ifdef KEYTRACE_ENABLE
+#    include "lib/keytrace.h"
+#endif
 
 #ifdef SWAP_HANDS_ENABLE
 __attribute__((weak)) const keypos_t PROGMEM hand_swap_config[MATRIX_ROWS][MATRIX_COLS] = {
@@ -154,13 +157,19 @@ bool oled_task_kb(void) {
     return false;
 }
 
+#endif // OLED_ENABLE
+
 bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
+#ifdef KEYTRACE_ENABLE
+    keytrace_record(record);
+#endif
+#ifdef OLED_ENABLE
     if (record->event.pressed) {
         set_keylog(keycode, record);
     }
+#endif
     return process_record_user(keycode, record);
 }
-#endif // OLED_ENABLE
 
 // https://zenn.dev/koron/articles/98324ab760e83a
 uint16_t keycode_config(uint16_t keycode) {
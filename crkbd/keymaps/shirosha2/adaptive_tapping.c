@@ -0,0 +1,333 @@
+/********************************************************************************************************************************/
+/*  adaptive_tapping.c                                                                                                          */
+/*                                                                                                                              */
+/*  This file is for the adaptive tapping term control.                                                                         */
+/*      - Per-key tap / hold duration histograms                                                                                */
+/*      - Per-key tapping term                                                                                                  */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  Each mod-tap key listed in Xuc_adtap_slot_map owns two histograms of press durations (16 buckets x 20ms, 4-bit counts):    */
+/*      - tap  : pressed and released with no other key pressed in between                                                      */
+/*      - hold : another key was pressed and released while this key was held                                                   */
+/*  Rolls (another key pressed, but still down when this key is released) are ambiguous and not counted.                        */
+/*  A counter reaching 15 halves the whole histogram, so old samples fade out.                                                  */
+/*                                                                                                                              */
+/*  The tapping term is put just above the 95th percentile of the taps, or halfway to the 5th percentile of the holds when      */
+/*  both are well separated. It is recomputed only when a sample is added, so get_tapping_term() is a table read.               */
+/*  Learned terms are written to the EEPROM user config (4 bits per key) once they have been stable for a while.                */
+/********************************************************************************************************************************/
+
+/********************************************************************************************************************************/
+/* Includes                                                                                                                     */
+/********************************************************************************************************************************/
+#include "adaptive_tapping.h"
+#include "luminous_common.h"
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_ADTAP_BUCKET_NUM          (16)        /* Number of histogram buckets                                        */
+#define Y_ADTAP_BUCKET_WIDTH        (20)        /* [ms] Width of a histogram bucket                                   */
+#define Y_ADTAP_HIST_SIZE           (Y_ADTAP_BUCKET_NUM / 2)    /* [byte] 2 buckets per byte                          */
+#define Y_ADTAP_COUNT_MAX           (0x0F)      /* Maximum count of a bucket                                          */
+
+#define Y_ADTAP_TAP_MIN_SAMPLES     (8)         /* Taps needed before the term is learned                             */
+#define Y_ADTAP_HOLD_MIN_SAMPLES    (4)         /* Holds needed before they are taken into account                    */
+#define Y_ADTAP_TAP_MARGIN          (20)        /* [ms] Margin above the tap durations                                */
+
+#define Y_ADTAP_TERM_DEFAULT        (TAPPING_TERM)  /* [ms] Term until the key has been learned (keymap term)         */
+#define Y_ADTAP_TERM_MIN            (60)        /* [ms] Minimum term                                                  */
+#define Y_ADTAP_TERM_MAX            (300)       /* [ms] Maximum term                                                  */
+#define Y_ADTAP_TERM_STEP           (20)        /* [ms] Term resolution (EEPROM code step)                            */
+#define Y_ADTAP_CODE_NONE           (0x00)      /* EEPROM code: not learned                                           */
+#define Y_ADTAP_CODE_MAX            (((Y_ADTAP_TERM_MAX - Y_ADTAP_TERM_MIN) / Y_ADTAP_TERM_STEP) + 1)
+
+#define Y_ADTAP_SAVE_DELAY          (60000)     /* [ms] Quiet time before a changed term is written to the EEPROM     */
+
+#define Y_ADTAP_FLG_HELD            (Y_BIT0)    /* Key is held                                                        */
+#define Y_ADTAP_FLG_OTHER_PRESSED   (Y_BIT1)    /* Another key was pressed while held                                 */
+#define Y_ADTAP_FLG_NESTED          (Y_BIT2)    /* Another key was pressed and released while held                    */
+
+/********************************************************************************************************************************/
+/*  Macros                                                                                                                      */
+/********************************************************************************************************************************/
+#define M_ADTAP_HIST_GET(puc_hist, uc_bucket)   (((puc_hist)[(uc_bucket) / 2] >> (((uc_bucket) & 1) * 4)) & Y_ADTAP_COUNT_MAX)
+#define M_ADTAP_TERM_TO_CODE(us_term)           ((uint8_t)((((us_term) - Y_ADTAP_TERM_MIN) / Y_ADTAP_TERM_STEP) + 1))
+#define M_ADTAP_CODE_TO_TERM(uc_code)           ((uint16_t)(Y_ADTAP_TERM_MIN + ((uc_code) - 1) * Y_ADTAP_TERM_STEP))
+
+_Static_assert(Y_ADTAP_SLOT_NUM * 4 <= 32, "adaptive_tapping: codes must fit in the 32-bit EEPROM user config");
+_Static_assert(Y_ADTAP_CODE_MAX <= 0x0F, "adaptive_tapping: term codes must fit in 4 bits");
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static uint8_t zuc_ADTAP_tap_hist[Y_ADTAP_SLOT_NUM][Y_ADTAP_HIST_SIZE] = {0};     /* [-,-] Tap duration histograms      */
+static uint8_t zuc_ADTAP_hold_hist[Y_ADTAP_SLOT_NUM][Y_ADTAP_HIST_SIZE] = {0};    /* [-,-] Hold duration histograms     */
+static uint16_t zus_ADTAP_press_time[Y_ADTAP_SLOT_NUM] = {0};                     /* [ms,1] Press timestamp             */
+static uint8_t zuc_ADTAP_flags[Y_ADTAP_SLOT_NUM] = {0};                           /* [-,-] Y_ADTAP_FLG_*                */
+static uint16_t zus_ADTAP_term[Y_ADTAP_SLOT_NUM] = {0};                           /* [ms,1] Current tapping term        */
+static uint32_t zul_ADTAP_saved_config = 0;                                       /* [-,-] EEPROM user config image     */
+static uint32_t zul_ADTAP_config = 0;                                             /* [-,-] Codes of the current terms   */
+static uint32_t zul_ADTAP_change_time = 0;                                        /* [ms,1] Last change of the codes    */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+static uint8_t m_adtap_get_slot(keypos_t st_key);
+static void m_adtap_hist_add(uint8_t puc_hist[], uint16_t us_duration);
+static void m_adtap_update_term(uint8_t uc_slot);
+
+/****************************************************************/
+/*  m_adtap_init                                                */
+/*--------------------------------------------------------------*/
+/*  Load the learned terms from the EEPROM.                     */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init                                  */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_adtap_init(void) {
+    zul_ADTAP_saved_config = eeconfig_read_user();                      /* Read the EEPROM user config      */
+    zul_ADTAP_config = 0;
+
+    for (uint8_t uc_slot = 0; uc_slot < Y_ADTAP_SLOT_NUM; uc_slot++) {
+        uint8_t uc_code = (zul_ADTAP_saved_config >> (uc_slot * 4)) & 0x0F;
+
+        if ((uc_code == Y_ADTAP_CODE_NONE) || (uc_code > Y_ADTAP_CODE_MAX)) {
+            zus_ADTAP_term[uc_slot] = Y_ADTAP_TERM_DEFAULT;             /* Not learned yet                  */
+        } else {
+            zus_ADTAP_term[uc_slot] = M_ADTAP_CODE_TO_TERM(uc_code);    /* Learned term                     */
+            zul_ADTAP_config |= (uint32_t)uc_code << (uc_slot * 4);
+        }
+    }
+}
+
+/****************************************************************/
+/*  m_adtap_task                                                */
+/*--------------------------------------------------------------*/
+/*  Write the learned terms to the EEPROM once they settled.    */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping                                        */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_adtap_task(void) {
+    if ((zul_ADTAP_config != zul_ADTAP_saved_config)
+     && (timer_elapsed32(zul_ADTAP_change_time) > Y_ADTAP_SAVE_DELAY)) {
+        eeconfig_update_user(zul_ADTAP_config);                         /* Write the EEPROM user config     */
+        zul_ADTAP_saved_config = zul_ADTAP_config;
+    }
+}
+
+/****************************************************************/
+/*  m_adtap_record                                              */
+/*--------------------------------------------------------------*/
+/*  Collect the press durations of the adaptive keys.           */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: key event (before tap / hold resolution)            */
+/*  Parameters: uint16_t keycode, keyrecord_t *record           */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_adtap_record(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t xuc_slot = m_adtap_get_slot(record->event.key);      /* Slot of the key                  */
+    const uint16_t xus_time = record->event.time;                       /* [ms,1] Event timestamp           */
+
+    if (record->event.pressed) {
+        /* Every held adaptive key sees another key pressed */
+        for (uint8_t uc_i = 0; uc_i < Y_ADTAP_SLOT_NUM; uc_i++) {
+            if (zuc_ADTAP_flags[uc_i] & Y_ADTAP_FLG_HELD) {
+                zuc_ADTAP_flags[uc_i] |= Y_ADTAP_FLG_OTHER_PRESSED;
+            }
+        }
+
+        if ((xuc_slot != Y_ADTAP_NO_SLOT) && IS_QK_MOD_TAP(keycode)) {
+            zus_ADTAP_press_time[xuc_slot] = xus_time;                  /* Start timing                     */
+            zuc_ADTAP_flags[xuc_slot] = Y_ADTAP_FLG_HELD;
+        }
+    } else {
+        if ((xuc_slot != Y_ADTAP_NO_SLOT) && (zuc_ADTAP_flags[xuc_slot] & Y_ADTAP_FLG_HELD)) {
+            const uint8_t xuc_flags = zuc_ADTAP_flags[xuc_slot];
+            const uint16_t xus_duration = TIMER_DIFF_16(xus_time, zus_ADTAP_press_time[xuc_slot]);
+
+            zuc_ADTAP_flags[xuc_slot] = 0;
+
+            if (!(xuc_flags & Y_ADTAP_FLG_OTHER_PRESSED)) {
+                m_adtap_hist_add(zuc_ADTAP_tap_hist[xuc_slot], xus_duration);   /* Lone press: tap      */
+                m_adtap_update_term(xuc_slot);
+            } else if (xuc_flags & Y_ADTAP_FLG_NESTED) {
+                m_adtap_hist_add(zuc_ADTAP_hold_hist[xuc_slot], xus_duration);  /* Nested press: hold   */
+                m_adtap_update_term(xuc_slot);
+            } else {
+                /* Roll: ambiguous, ignore */
+            }
+        }
+
+        /* Held adaptive keys that saw another press now saw it released as well */
+        for (uint8_t uc_i = 0; uc_i < Y_ADTAP_SLOT_NUM; uc_i++) {
+            if ((zuc_ADTAP_flags[uc_i] & (Y_ADTAP_FLG_HELD | Y_ADTAP_FLG_OTHER_PRESSED))
+             == (Y_ADTAP_FLG_HELD | Y_ADTAP_FLG_OTHER_PRESSED)) {
+                zuc_ADTAP_flags[uc_i] |= Y_ADTAP_FLG_NESTED;
+            }
+        }
+    }
+}
+
+/****************************************************************/
+/*  m_adtap_tapping_term                                        */
+/*--------------------------------------------------------------*/
+/*  Tapping term of the key.                                    */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: get_tapping_term                                    */
+/*  Parameters: uint16_t keycode, keyrecord_t *record           */
+/*  Returns: <uint16_t> [ms] Tapping term                       */
+/****************************************************************/
+uint16_t m_adtap_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t xuc_slot = m_adtap_get_slot(record->event.key);
+
+    if ((xuc_slot != Y_ADTAP_NO_SLOT) && IS_QK_MOD_TAP(keycode)) {
+        return zus_ADTAP_term[xuc_slot];
+    }
+    return TAPPING_TERM;
+}
+
+/****************************************************************/
+/*  m_adtap_get_slot                                            */
+/*--------------------------------------------------------------*/
+/*  Slot of the key position.                                   */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: keypos_t st_key                                 */
+/*  Returns: <uint8_t> Slot or Y_ADTAP_NO_SLOT                  */
+/****************************************************************/
+static uint8_t m_adtap_get_slot(keypos_t st_key) {
+    if ((st_key.row >= MATRIX_ROWS) || (st_key.col >= MATRIX_COLS)) {
+        return Y_ADTAP_NO_SLOT;                                         /* Combo, encoder, ...              */
+    }
+    return pgm_read_byte(&Xuc_adtap_slot_map[st_key.row][st_key.col]);
+}
+
+/****************************************************************/
+/*  m_adtap_hist_add                                            */
+/*--------------------------------------------------------------*/
+/*  Count a duration in a histogram.                            */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Histogram>, uint16_t [ms] duration             */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_adtap_hist_add(uint8_t puc_hist[], uint16_t us_duration) {
+    uint8_t uc_bucket = us_duration / Y_ADTAP_BUCKET_WIDTH;
+
+    if (uc_bucket >= Y_ADTAP_BUCKET_NUM) {
+        uc_bucket = Y_ADTAP_BUCKET_NUM - 1;                             /* Last bucket collects the rest    */
+    }
+
+    if (M_ADTAP_HIST_GET(puc_hist, uc_bucket) == Y_ADTAP_COUNT_MAX) {
+        /* Halve every bucket (both nibbles of each byte at once) */
+        for (uint8_t uc_i = 0; uc_i < Y_ADTAP_HIST_SIZE; uc_i++) {
+            puc_hist[uc_i] = (puc_hist[uc_i] >> 1) & 0x77;
+        }
+    }
+
+    puc_hist[uc_bucket / 2] += (uc_bucket & 1) ? 0x10 : 0x01;
+}
+
+/****************************************************************/
+/*  m_adtap_update_term                                         */
+/*--------------------------------------------------------------*/
+/*  Derive the tapping term of a slot from its histograms.      */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: sample added                                        */
+/*  Parameters: uint8_t uc_slot                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_adtap_update_term(uint8_t uc_slot) {
+    const uint8_t *xpuc_tap = zuc_ADTAP_tap_hist[uc_slot];
+    const uint8_t *xpuc_hold = zuc_ADTAP_hold_hist[uc_slot];
+    uint16_t us_tap_total = 0;                                          /* Number of tap samples            */
+    uint16_t us_hold_total = 0;                                         /* Number of hold samples           */
+    uint16_t us_tap_upper = 0;                                          /* [ms] 95th percentile of the taps */
+    uint16_t us_hold_lower = 0;                                         /* [ms] 5th percentile of the holds */
+    uint16_t us_cumul;
+    uint16_t us_term;
+    uint8_t uc_code;
+
+    for (uint8_t uc_b = 0; uc_b < Y_ADTAP_BUCKET_NUM; uc_b++) {
+        us_tap_total += M_ADTAP_HIST_GET(xpuc_tap, uc_b);
+        us_hold_total += M_ADTAP_HIST_GET(xpuc_hold, uc_b);
+    }
+
+    if (us_tap_total < Y_ADTAP_TAP_MIN_SAMPLES) {
+        return;                                                         /* Keep the current term            */
+    }
+
+    us_cumul = 0;
+    for (uint8_t uc_b = 0; uc_b < Y_ADTAP_BUCKET_NUM; uc_b++) {
+        us_cumul += M_ADTAP_HIST_GET(xpuc_tap, uc_b);
+        if (us_cumul * 20 >= us_tap_total * 19) {
+            us_tap_upper = (uc_b + 1) * Y_ADTAP_BUCKET_WIDTH;
+            break;
+        }
+    }
+    us_term = us_tap_upper + Y_ADTAP_TAP_MARGIN;
+
+    if (us_hold_total >= Y_ADTAP_HOLD_MIN_SAMPLES) {
+        us_cumul = 0;
+        for (uint8_t uc_b = 0; uc_b < Y_ADTAP_BUCKET_NUM; uc_b++) {
+            us_cumul += M_ADTAP_HIST_GET(xpuc_hold, uc_b);
+            if (us_cumul * 20 > us_hold_total) {
+                us_hold_lower = uc_b * Y_ADTAP_BUCKET_WIDTH;
+                break;
+            }
+        }
+        if (us_hold_lower > us_term) {
+            us_term = (us_tap_upper + us_hold_lower) / 2;               /* Halfway between taps and holds   */
+        }
+    }
+
+    /* Clamp and round to the EEPROM resolution */
+    if (us_term < Y_ADTAP_TERM_MIN) {
+        us_term = Y_ADTAP_TERM_MIN;
+    } else if (us_term > Y_ADTAP_TERM_MAX) {
+        us_term = Y_ADTAP_TERM_MAX;
+    }
+    uc_code = M_ADTAP_TERM_TO_CODE(us_term + Y_ADTAP_TERM_STEP / 2);
+    if (uc_code > Y_ADTAP_CODE_MAX) {
+        uc_code = Y_ADTAP_CODE_MAX;
+    }
+    zus_ADTAP_term[uc_slot] = M_ADTAP_CODE_TO_TERM(uc_code);
+
+    if (((zul_ADTAP_config >> (uc_slot * 4)) & 0x0F) != uc_code) {
+        zul_ADTAP_config &= ~((uint32_t)0x0F << (uc_slot * 4));
+        zul_ADTAP_config |= (uint32_t)uc_code << (uc_slot * 4);
+        zul_ADTAP_change_time = timer_read32();                         /* Restart the save delay           */
+    }
+}
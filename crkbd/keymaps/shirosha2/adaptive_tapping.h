@@ -0,0 +1,50 @@
+/********************************************************************************************************************************/
+/*  adaptive_tapping.h                                                                                                          */
+/*                                                                                                                              */
+/*  This file is for the adaptive tapping term control.                                                                         */
+/*      - Per-key tap / hold duration histograms                                                                                */
+/*      - Per-key tapping term                                                                                                  */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Includes                                                                                                                    */
+/********************************************************************************************************************************/
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_ADTAP_SLOT_NUM        (8)         /* Number of adaptive keys (4 bits each in the EEPROM user config)    */
+#define Y_ADTAP_NO_SLOT         (0xFF)      /* Not an adaptive key                                                */
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+extern const uint8_t Xuc_adtap_slot_map[MATRIX_ROWS][MATRIX_COLS];
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+void m_adtap_init(void);
+void m_adtap_task(void);
+void m_adtap_record(uint16_t keycode, keyrecord_t *record);
+uint16_t m_adtap_tapping_term(uint16_t keycode, keyrecord_t *record);
@@ -0,0 +1,30 @@
+/* Generated by tools/anim_encode.cpp: 8 frames, 125 ms per frame, loop, 430 bytes */
+const uint8_t PROGMEM Xuc_boot_anim[] = {
+    0x08, 0x01, 0x7d, 0x00, 0x76, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x7c, 0x04, 0xff, 0xff, 0xff, 0xff,
+    0x7c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x7c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x66, 0x04,
+    0xf8, 0xf8, 0xf8, 0xf8, 0x0c, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff,
+    0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff,
+    0xff, 0xff, 0x6c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x0c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00,
+    0x56, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x0c, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x6c, 0x04, 0xff, 0xff,
+    0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04,
+    0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x0c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f,
+    0x00, 0x00, 0x46, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x0c, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x6c, 0x04,
+    0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff,
+    0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x0c, 0x04, 0x1f, 0x1f,
+    0x1f, 0x1f, 0x00, 0x00, 0x36, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x0c, 0x04, 0xf8, 0xf8, 0xf8, 0xf8,
+    0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0xff, 0xff,
+    0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x0c, 0x04,
+    0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x26, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x0c, 0x04, 0xf8, 0xf8,
+    0xf8, 0xf8, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04,
+    0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f,
+    0x0c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x16, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x0c, 0x04,
+    0xf8, 0xf8, 0xf8, 0xf8, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff,
+    0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0x1f, 0x1f,
+    0x1f, 0x1f, 0x0c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x06, 0x04, 0xf8, 0xf8, 0xf8, 0xf8,
+    0x0c, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff,
+    0xff, 0xff, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04,
+    0x1f, 0x1f, 0x1f, 0x1f, 0x0c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x06, 0x04, 0xf8, 0xf8,
+    0xf8, 0xf8, 0x6c, 0x04, 0xf8, 0xf8, 0xf8, 0xf8, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04,
+    0xff, 0xff, 0xff, 0xff, 0x0c, 0x04, 0xff, 0xff, 0xff, 0xff, 0x6c, 0x04, 0xff, 0xff, 0xff, 0xff,
+    0x0c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x6c, 0x04, 0x1f, 0x1f, 0x1f, 0x1f, 0x00, 0x00,
+};
@@ -30,13 +30,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // #define EE_HANDS
 
 #define USE_SERIAL_PD2
+#define SPLIT_ACTIVITY_ENABLE   /* Slave follows the master into the idle / sleep states */
+#define SPLIT_TRANSACTION_IDS_USER RPC_ID_USER_LMCTL_STATE, RPC_ID_USER_TLM_CHUNK   /* Scheduled in split_sync.c */
+#define SPLIT_MAX_CONNECTION_ERRORS 3       /* Failed scans before the link is dropped (default 10)     */
+#define SPLIT_CONNECTION_CHECK_TIMEOUT 20   /* [ms] Retry period while it is down (default 500)          */
 
 #define TAPPING_FORCE_HOLD
 #define TAPPING_TERM 100
+#define TAPPING_TERM_PER_KEY    /* Home row mod-taps: see adaptive_tapping.c */
 
-#define OLED_DRIVER_ENABLE (1)
+#ifndef OLED_DRIVER_ENABLE
+#define OLED_DRIVER_ENABLE (1)         /* 0: no OLED code in the keymap (build with OLED_ENABLE=no as well) */
+#endif
 #define OLED_FONT_H "keyboards/crkbd/lib/glcdfont.c"
-#define OLED_UPDATE_INTERVAL (64)
+#include "luminous_config.h"
+#define OLED_UPDATE_INTERVAL (1000 / LMCTL_OLED_FPS)
+#define EECONFIG_USER_DATA_SIZE (32)    /* Luminous settings log: see luminous_store.c */
+// #define LATENCY_PROBE_PIN B6         /* Toggled on every keyboard report: see latency_probe.c */
 
 
 // https://zenn.dev/koron/articles/98324ab760e83a
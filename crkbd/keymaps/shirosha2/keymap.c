@@ -22,6 +22,24 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "luminous_control.h"
 #include "luminous_common.h"
+#include "adaptive_tapping.h"
+#include "split_sync.h"
+#ifdef RAW_ENABLE
+#include "telemetry.h"
+#endif
+#ifdef LATENCY_PROBE_PIN
+#include "latency_probe.h"
+#endif
+
+/* Home row mod-taps (tapping term learned per key, see adaptive_tapping.c) */
+#define HM_A    LGUI_T(KC_A)
+#define HM_S    LALT_T(KC_S)
+#define HM_D    LCTL_T(KC_D)
+#define HM_F    LSFT_T(KC_F)
+#define HM_J    RSFT_T(KC_J)
+#define HM_K    RCTL_T(KC_K)
+#define HM_L    LALT_T(KC_L)
+#define HM_SCLN RGUI_T(KC_SCLN)
 
 
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
@@ -29,7 +47,7 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
   //,-----------------------------------------------------.                    ,-----------------------------------------------------.
        KC_TAB,    KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,                         KC_Y,    KC_U,    KC_I,    KC_O,   KC_P,  KC_BSPC,
   //|--------+--------+--------+--------+--------+--------|                    |--------+--------+--------+--------+--------+--------|
-      KC_LCTL,    KC_A,    KC_S,    KC_D,    KC_F,    KC_G,                         KC_H,    KC_J,    KC_K,    KC_L, KC_SCLN, KC_QUOT,
+      KC_LCTL,    HM_A,    HM_S,    HM_D,    HM_F,    KC_G,                         KC_H,    HM_J,    HM_K,    HM_L, HM_SCLN, KC_QUOT,
   //|--------+--------+--------+--------+--------+--------|                    |--------+--------+--------+--------+--------+--------|
       KC_LSFT,    KC_Z,    KC_X,    KC_C,    KC_V,    KC_B,                         KC_N,    KC_M, KC_COMM,  KC_DOT, KC_SLSH, KC_RSFT,
   //|--------+--------+--------+--------+--------+--------+--------|  |--------+--------+--------+--------+--------+--------+--------|
@@ -66,7 +84,7 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
   //,-----------------------------------------------------.                    ,-----------------------------------------------------.
       LM_INSP, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                      XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
   //|--------+--------+--------+--------+--------+--------|                    |--------+--------+--------+--------+--------+--------|
-      XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                      XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+      LM_NEXT, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                      XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
   //|--------+--------+--------+--------+--------+--------|                    |--------+--------+--------+--------+--------+--------|
       XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,                      XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
   //|--------+--------+--------+--------+--------+--------+--------|  |--------+--------+--------+--------+--------+--------+--------|
@@ -76,6 +94,57 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 };
 
 
+const uint8_t PROGMEM Xuc_adtap_slot_map[MATRIX_ROWS][MATRIX_COLS] = {  // For adaptive tapping term (home row mod-taps)
+/*        0     1     2     3     4     5 */
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },     /* Left  top    */
+    { 0xFF,    0,    1,    2,    3, 0xFF },     /* Left  home   : A S D F       */
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },     /* Left  bottom */
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },     /* Left  thumb  */
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },     /* Right top    */
+    { 0xFF,    7,    6,    5,    4, 0xFF },     /* Right home   : ; L K J (columns are mirrored) */
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },     /* Right bottom */
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },     /* Right thumb  */
+};
+
+void keyboard_post_init_user(void) {
+    m_adtap_init();                     // Load the learned tapping terms
+#ifdef RAW_ENABLE
+    m_tlm_init();                       // Start the telemetry time base
+#endif
+#ifdef LATENCY_PROBE_PIN
+    m_lprb_init();                      // Drive the latency probe pin low
+#endif
+#if (OLED_DRIVER_ENABLE == 1)
+    m_lmctl_init();                     // Restore the luminous settings
+#endif
+    m_sync_init();                      // Register the split transactions
+}
+
+void housekeeping_task_user(void) {
+#ifdef RAW_ENABLE
+    m_tlm_loop();                       // Count and time the main loop
+#endif
+#ifdef LATENCY_PROBE_PIN
+    m_lprb_task();                      // Probe the reports once USB is up
+#endif
+    m_adtap_task();                     // Save the learned tapping terms
+#if (OLED_DRIVER_ENABLE == 1)
+    m_lmctl_housekeeping();             // Luminous settings write-back
+#endif
+    m_sync_task();                      // Keymap split transactions, after the matrix sync
+}
+
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    m_adtap_record(keycode, record);    // Raw key events, before tap / hold resolution
+
+    return true;
+}
+
+uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
+    return m_adtap_tapping_term(keycode, record);
+}
+
+
 #if (OLED_DRIVER_ENABLE == 1)
 const char PROGMEM Xc_logo_indices[] = {  // For Luminous Control #1200 (OLED Startup Logo)
 /*     0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,   15,   16,   17,   18,   19,   20*/
@@ -86,6 +155,11 @@ const char PROGMEM Xc_logo_indices[] = {  // For Luminous Control #1200 (OLED St
     0
 };
 
+#if (LMCTL_1201_BOOT_ANIM_ENABLE == 1)
+// For Luminous Control #1201 (Boot animation): tools/anim_encode.cpp --loop tools/fixtures/boot_anim/f*.pbm > boot_anim.h
+#include "boot_anim.h"
+#endif
+
 oled_rotation_t oled_init_user(oled_rotation_t rotation) {
   if (!is_keyboard_master()) {
     return OLED_ROTATION_180;  // flips the display 180 degrees if offhand
@@ -164,7 +238,13 @@ void render_bootmagic_status(bool status) {
 }
 
 bool oled_task_user(void) {
+#ifdef RAW_ENABLE
+    m_tlm_oled_begin();
+#endif
     m_lmctl_main(); // Call luminous control main function
+#ifdef RAW_ENABLE
+    m_tlm_oled_end();
+#endif
 
     return false;   // This means we skip crkbd's default OLED task
 }
@@ -174,6 +254,9 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
 //     set_keylog(keycode, record);
 //   }
     m_lmctl_record(keycode, record); // Call luminous control record function
+#ifdef RAW_ENABLE
+    m_tlm_record(record);            // Count the key events
+#endif
 
     return true;
 }
@@ -0,0 +1,120 @@
+/********************************************************************************************************************************/
+/*  latency_probe.c                                                                                                             */
+/*                                                                                                                              */
+/*  This file is for the key-to-report latency probe.                                                                           */
+/*      - GPIO edge on every keyboard report handed to USB                                                                      */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  Enabled by defining LATENCY_PROBE_PIN in config.h (a free Pro Micro pin: B2, B4, B5 or B6).                                 */
+/*                                                                                                                              */
+/*  The USB host driver is wrapped so that LATENCY_PROBE_PIN toggles right after every keyboard (or NKRO) report is written to  */
+/*  the endpoint. Capture a switch terminal (its column line) and the probe pin on a logic analyzer, or drive the column pin    */
+/*  and trace the probe pin in a simulator: the time from the switch edge to the next probe edge is the key-to-report latency.  */
+/*  Toggling instead of pulsing keeps one edge per report however close the reports are, and needs no state to end a pulse.    */
+/*                                                                                                                              */
+/*  In simulation, tools/split_sim.cpp --probe B6 drives the switches of both halves and times each report by its probe edge.   */
+/*  tools/latency_bench.sh builds the keymap with the OLED, the RGB and the idle effects on and off and prints the latency      */
+/*  distribution of each build, while typing and on the first key after idle. The probe itself costs one port write per report. */
+/********************************************************************************************************************************/
+
+/********************************************************************************************************************************/
+/* Includes                                                                                                                     */
+/********************************************************************************************************************************/
+#include "latency_probe.h"
+#include QMK_KEYBOARD_H
+#include "host.h"
+#include "host_driver.h"
+
+#ifdef LATENCY_PROBE_PIN
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static host_driver_t zst_LPRB_driver;                               /* [-,-] USB driver with the probed reports       */
+static host_driver_t *zpst_LPRB_usb_driver = NULL;                  /* [-,-] USB driver                               */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+static void m_lprb_send_keyboard(report_keyboard_t *report);
+static void m_lprb_send_nkro(report_nkro_t *report);
+
+/****************************************************************/
+/*  m_lprb_init                                                 */
+/*--------------------------------------------------------------*/
+/*  Drive the probe pin low.                                    */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init                                  */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lprb_init(void) {
+    gpio_set_pin_output(LATENCY_PROBE_PIN);
+    gpio_write_pin_low(LATENCY_PROBE_PIN);
+}
+
+/****************************************************************/
+/*  m_lprb_task                                                 */
+/*--------------------------------------------------------------*/
+/*  Wrap the USB driver once it is registered.                  */
+/*  (It is set after keyboard_post_init)                        */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping                                        */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lprb_task(void) {
+    host_driver_t *pst_driver = host_get_driver();
+
+    if ((pst_driver == NULL) || (pst_driver == &zst_LPRB_driver)) {
+        return;
+    }
+    zpst_LPRB_usb_driver = pst_driver;
+    zst_LPRB_driver = *pst_driver;
+    zst_LPRB_driver.send_keyboard = m_lprb_send_keyboard;
+    zst_LPRB_driver.send_nkro = m_lprb_send_nkro;
+    host_set_driver(&zst_LPRB_driver);
+}
+
+/****************************************************************/
+/*  m_lprb_send_keyboard / m_lprb_send_nkro                     */
+/*--------------------------------------------------------------*/
+/*  Send the report, then toggle the probe pin.                 */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard report is sent                             */
+/*  Parameters: <Report>                                        */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lprb_send_keyboard(report_keyboard_t *report) {
+    zpst_LPRB_usb_driver->send_keyboard(report);
+    gpio_toggle_pin(LATENCY_PROBE_PIN);
+}
+
+static void m_lprb_send_nkro(report_nkro_t *report) {
+    zpst_LPRB_usb_driver->send_nkro(report);
+    gpio_toggle_pin(LATENCY_PROBE_PIN);
+}
+
+#endif /* LATENCY_PROBE_PIN */
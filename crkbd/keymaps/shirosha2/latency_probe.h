@@ -0,0 +1,36 @@
+/********************************************************************************************************************************/
+/*  latency_probe.h                                                                                                             */
+/*                                                                                                                              */
+/*  This file is for the key-to-report latency probe.                                                                           */
+/*      - GPIO edge on every keyboard report handed to USB                                                                      */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Includes                                                                                                                    */
+/********************************************************************************************************************************/
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+void m_lprb_init(void);
+void m_lprb_task(void);
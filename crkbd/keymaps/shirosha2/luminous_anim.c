@@ -0,0 +1,181 @@
+/********************************************************************************************************************************/
+/*  luminous_anim.c                                                                                                             */
+/*                                                                                                                              */
+/*  This file is for the player of the pre-rendered OLED animations (XOR-delta frames in PROGMEM).                              */
+/*  The animations are made with tools/anim_encode.cpp.                                                                         */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  A raw frame is the whole 512-byte driver buffer. The frames here only hold the bytes that change from the previous frame,  */
+/*  XOR-ed straight into the driver buffer with oled_write_raw_byte(), which marks dirty only the blocks it changes. Flash use  */
+/*  and the I2C traffic of a frame both follow the part of the picture that moves. The format is in luminous_anim.h.           */
+/********************************************************************************************************************************/
+
+/********************************************************************************************************************************/
+/* Includes                                                                                                                     */
+/********************************************************************************************************************************/
+#include "luminous_anim.h"
+#include "luminous_common.h"
+#include QMK_KEYBOARD_H
+#if (OLED_DRIVER_ENABLE == 1)
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_LMAN_BUFFER_SIZE      (512)       /* [byte] Driver buffer (128 x 32)                        */
+#define Y_LMAN_CATCH_UP_MAX     (2)         /* [frame] Frames applied per call when behind            */
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static const uint8_t *zpuc_LMAN_anim = NULL;                        /* [-,-] Playing animation (PROGMEM), NULL: none */
+static const uint8_t *zpuc_LMAN_next = NULL;                        /* [-,-] Next frame (PROGMEM)                    */
+static const uint8_t *zpuc_LMAN_loop = NULL;                        /* [-,-] Frame 1, where a loop goes on (PROGMEM) */
+static uint8_t zuc_LMAN_frame = 0;                                  /* [-,-] Frames applied in this pass             */
+static uint8_t zuc_LMAN_frame_num = 0;                              /* [-,-] Frames of the animation                 */
+static uint8_t zuc_LMAN_flags = 0;                                  /* [-,-] Animation flags                         */
+static uint16_t zus_LMAN_frame_time = 0;                            /* [ms,1] Time per frame                         */
+static uint16_t zus_LMAN_elapsed = 0;                               /* [ms,1] Time since the last frame              */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+static const uint8_t *m_lman_apply(const uint8_t *puc_frame);
+
+/****************************************************************/
+/*  m_lman_start                                                */
+/*--------------------------------------------------------------*/
+/*  Start an animation and show its frame 0 over the buffer     */
+/*  (a cleared OLED shows the picture as drawn).                */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Animation (PROGMEM)>                           */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lman_start(const uint8_t *puc_anim) {
+    zuc_LMAN_frame_num = pgm_read_byte(&puc_anim[0]);
+    zuc_LMAN_flags = pgm_read_byte(&puc_anim[1]);
+    zus_LMAN_frame_time = (uint16_t)pgm_read_byte(&puc_anim[2]) | ((uint16_t)pgm_read_byte(&puc_anim[3]) << 8);
+    zus_LMAN_elapsed = 0;
+    if (zuc_LMAN_frame_num == 0) {
+        zpuc_LMAN_anim = NULL;                                          /* Nothing to play                  */
+        return;
+    }
+    zpuc_LMAN_anim = puc_anim;
+    zpuc_LMAN_next = m_lman_apply(&puc_anim[Y_LMAN_HEADER_SIZE]);       /* Frame 0                          */
+    zpuc_LMAN_loop = zpuc_LMAN_next;
+    zuc_LMAN_frame = 1;
+}
+
+/****************************************************************/
+/*  m_lman_task                                                 */
+/*--------------------------------------------------------------*/
+/*  Apply the frames that are due. A one-shot animation stays   */
+/*  on its last frame.                                          */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <Delta time [ms]>                               */
+/*  Returns: <uint8_t> Y_ON while playing                       */
+/****************************************************************/
+uint8_t m_lman_task(uint16_t us_delta_time) {
+    uint8_t uc_budget = Y_LMAN_CATCH_UP_MAX;                            /* Frames left for this call        */
+
+    if (zpuc_LMAN_anim == NULL) {
+        return Y_OFF;
+    }
+    zus_LMAN_elapsed = (us_delta_time > (UINT16_MAX - zus_LMAN_elapsed)) ? UINT16_MAX : (uint16_t)(zus_LMAN_elapsed + us_delta_time);
+
+    while ((zus_LMAN_elapsed >= zus_LMAN_frame_time) && (uc_budget != 0)) {
+        zus_LMAN_elapsed -= zus_LMAN_frame_time;
+        uc_budget--;
+        if (zuc_LMAN_frame < zuc_LMAN_frame_num) {
+            zpuc_LMAN_next = m_lman_apply(zpuc_LMAN_next);              /* Frame N from frame N-1           */
+            zuc_LMAN_frame++;
+        } else if ((zuc_LMAN_flags & Y_LMAN_FLAG_LOOP) != 0) {
+            (void)m_lman_apply(zpuc_LMAN_next);                         /* Back to frame 0                  */
+            zpuc_LMAN_next = zpuc_LMAN_loop;
+            zuc_LMAN_frame = 1;
+        } else {
+            zpuc_LMAN_anim = NULL;                                      /* Done, the last frame stays       */
+            return Y_OFF;
+        }
+    }
+    if (uc_budget == 0) {
+        zus_LMAN_elapsed = 0;                                           /* Too far behind: drop the time    */
+    }
+    return Y_ON;
+}
+
+/****************************************************************/
+/*  m_lman_stop                                                 */
+/*--------------------------------------------------------------*/
+/*  Stop the animation. The buffer keeps the current frame.     */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lman_stop(void) {
+    zpuc_LMAN_anim = NULL;
+}
+
+/****************************************************************/
+/*  m_lman_apply                                                */
+/*--------------------------------------------------------------*/
+/*  XOR the runs of one frame into the driver buffer.           */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Frame (PROGMEM)>                               */
+/*  Returns: <const uint8_t *> Next frame (PROGMEM)             */
+/****************************************************************/
+static const uint8_t *m_lman_apply(const uint8_t *puc_frame) {
+    const uint8_t *xpuc_oled = (const uint8_t *)oled_read_raw(0).current_element; /* Driver buffer   */
+    uint16_t us_idx = 0;                                                /* Driver byte index                */
+    uint8_t uc_skip;                                                    /* Bytes left as they are           */
+    uint8_t uc_len;                                                     /* Bytes XOR-ed                     */
+
+    for (;;) {
+        uc_skip = pgm_read_byte(puc_frame++);
+        while (uc_skip == Y_LMAN_SKIP_EXT) {
+            us_idx += Y_LMAN_SKIP_EXT;
+            uc_skip = pgm_read_byte(puc_frame++);
+        }
+        us_idx += uc_skip;
+        uc_len = pgm_read_byte(puc_frame++);
+        if (uc_len == 0) {
+            break;                                                      /* End of the frame                 */
+        }
+        for (; uc_len != 0; uc_len--) {
+            const uint8_t xuc_xor = pgm_read_byte(puc_frame++);         /* Changed bits                     */
+
+            if (us_idx < Y_LMAN_BUFFER_SIZE) {                          /* Never past the buffer            */
+                oled_write_raw_byte(xpuc_oled[us_idx] ^ xuc_xor, us_idx);
+            }
+            us_idx++;
+        }
+    }
+    return puc_frame;
+}
+
+#endif /* OLED_DRIVER_ENABLE */
@@ -0,0 +1,53 @@
+/********************************************************************************************************************************/
+/*  luminous_anim.h                                                                                                             */
+/*                                                                                                                              */
+/*  This file is for the player of the pre-rendered OLED animations (XOR-delta frames in PROGMEM).                              */
+/*  The animations are made with tools/anim_encode.cpp.                                                                         */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Includes                                                                                                                    */
+/********************************************************************************************************************************/
+#include "luminous_common.h"
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/*                                                                                                                              */
+/*  Animation format (must match tools/anim_encode.cpp)                                                                         */
+/*      Header  : <frame count>, <flags>, <frame time [ms] (2 bytes, little endian)>                                            */
+/*      Frame   : runs, each <skip> <len> <len XOR bytes>, ended by a run with <len> = 0                                        */
+/*                  skip : driver bytes left as they are before the run, 0xFF adds 255 and another <skip> byte follows         */
+/*                  len  : driver bytes XOR-ed with the next <len> bytes (1 ~ 255)                                              */
+/*      Frame 0 is the delta from a cleared buffer, frame N the delta from frame N-1. With Y_LMAN_FLAG_LOOP one more frame,     */
+/*      the delta from the last frame back to frame 0, follows the last frame.                                                  */
+/********************************************************************************************************************************/
+#define Y_LMAN_HEADER_SIZE      (4)         /* [byte] Animation header                                */
+#define Y_LMAN_FLAG_LOOP        (Y_BIT0)    /* Play forever (closing delta included)                  */
+#define Y_LMAN_SKIP_EXT         (0xFF)      /* Skip byte continued by another skip byte               */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+void m_lman_start(const uint8_t *puc_anim);
+uint8_t m_lman_task(uint16_t us_delta_time);
+void m_lman_stop(void);
@@ -40,6 +40,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define Y_BIT7  (0x80U)                     /* Bit 7    */
 
 #define LM_INSP (QK_USER_0)                 /* Luminous control inspection mode toggle key  */
+#define LM_NEXT (QK_USER_1)                 /* Luminous control next idle effect key        */
+
+#define Y_TIMER1_PRESCALER      (8)                                             /* Timer1 clock F_CPU / 8, wraps every 32.8 ms  */
+#define Y_TIMER1_TICKS_PER_US   (F_CPU / (Y_TIMER1_PRESCALER * 1000000UL))      /* Timer1 ticks per microsecond                 */
 
 /********************************************************************************************************************************/
 /*  Macros                                                                                                                      */
@@ -57,3 +61,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /*                                                              */
 /****************************************************************/
 #define M_CLIP_INC(value, max)  { (value) = (value) < (max) ? (value) + 1 : (value); }
+
+/****************************************************************/
+/*  M_TIMER1_INIT / M_TIMER1_TICKS                              */
+/*--------------------------------------------------------------*/
+/*  The one Timer1 time base of the keymap, free running at     */
+/*  F_CPU / Y_TIMER1_PRESCALER. Every user starts it with       */
+/*  M_TIMER1_INIT (the same setting, so any order is fine) and  */
+/*  reads it with M_TIMER1_TICKS. 0 off the AVR.                */
+/****************************************************************/
+#if defined(__AVR__)
+#define M_TIMER1_INIT()         { TCCR1A = 0; TCCR1B = _BV(CS11); }
+#define M_TIMER1_TICKS()        (TCNT1)
+#else
+#define M_TIMER1_INIT()         { }
+#define M_TIMER1_TICKS()        ((uint16_t)0)
+#endif /* __AVR__ */
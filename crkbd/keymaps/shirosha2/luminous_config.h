@@ -27,4 +27,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /********************************************************************************************************************************/
 /*  defines                                                                                                                     */
 /********************************************************************************************************************************/
+/* The feature switches may be set from the build: qmk compile -e EXTRAFLAGS="-DLMCTL_1501_LABYRINTH_ENABLE=1" */
+#ifndef LMCTL_1501_LABYRINTH_ENABLE
 #define LMCTL_1501_LABYRINTH_ENABLE (0)         /* 0: Labyrinth disable      1: Labyrinth enable */
+#endif
+#ifndef LMCTL_1502_LIFE_ENABLE
+#define LMCTL_1502_LIFE_ENABLE      (0)         /* 0: Game of Life disable   1: Game of Life enable */
+#endif
+#ifndef LMCTL_1201_BOOT_ANIM_ENABLE
+#define LMCTL_1201_BOOT_ANIM_ENABLE (0)         /* 0: Startup logo           1: Boot animation (Xuc_boot_anim[] of boot_anim.h, tools/anim_encode.cpp) */
+#endif
+// #define LMCTL_1502_MEASURE_CYCLES            /* Time the Life generations with Timer1 (shown in LM_INSP) */
+#define LMCTL_OLED_FPS              (16)        /* [fps] OLED frame rate (4 ~ 30), animation speed does not depend on it */
+#define LMCTL_SRAM_BUDGET           (1024)      /* [byte] Upper limit of the luminous control static buffers (2560 bytes SRAM on the 32u4) */
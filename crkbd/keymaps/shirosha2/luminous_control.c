@@ -33,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /*      #13xx: OLED display control (Main Key Pressed)                                                                          */
 /*      #14xx: OLED display control (Main Key Released)                                                                         */
 /*      #15xx: OLED display control (Idle)                                                                                      */
+/*      #16xx: OLED display control (Inspection)                                                                                */
 /*      #19xx: OLED display control (Main Easter Egg)                                                                           */
 /*                                                                                                                              */
 /********************************************************************************************************************************/
@@ -43,8 +44,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "luminous_config.h"
 #include "luminous_control.h"
 #include "luminous_common.h"
+#include "luminous_store.h"
+#if (OLED_DRIVER_ENABLE == 1)
+#include "luminous_font.h"
+#include "luminous_hwfx.h"
+#if (LMCTL_1201_BOOT_ANIM_ENABLE == 1)
+#include "luminous_anim.h"
+#endif /* LMCTL_1201_BOOT_ANIM_ENABLE */
+#endif /* OLED_DRIVER_ENABLE */
 #include QMK_KEYBOARD_H
 #include <stdio.h>
+#ifdef KEYTRACE_ENABLE
+#include "lib/keytrace.h"
+#endif /* KEYTRACE_ENABLE */
 
 #ifdef CONSOLE_ENABLE
   #include <print.h>
@@ -54,32 +66,54 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /*  Typedefs                                                                                                                    */
 /********************************************************************************************************************************/
 typedef struct {
-    uint32_t ul_app_timestamp;          /* [ms,64] Timestamp on the application side    */
+    uint32_t ul_app_timestamp;          /* [ms,1] Timestamp on the application side     */
+    uint32_t ul_frame_time;             /* [ms,1] timer_read32() at the last frame      */
+    uint16_t us_delta_time;             /* [ms,1] Time since the last frame             */
     uint8_t uc_master_mode_flg;         /* Master mode flag                             */
     uint8_t uc_lmctl_state;             /* Luminous control state                       */
     uint16_t us_layer_state;            /* Layer state                                  */
+    uint32_t ul_inactive_time;          /* [ms,1] Time since the last key event         */
 } lmctl_context_t;
 
 /********************************************************************************************************************************/
 /*  Defines                                                                                                                     */
 /********************************************************************************************************************************/
-#define Y_LMCTL_TASK_INTERVAL   (64)        /* [ms,64] 64ms                                           */
-#define Y_LMCTL_STARTUP_TIME    (64)        /* [ms,64] 64 * Y_LMCTL_TASK_INTERVAL(64) = 4.096s        */
+#define Y_LMCTL_STARTUP_TIME    (4096)      /* [ms,1] 4.096s                                          */
+#define Y_LMCTL_DELTA_TIME_MAX  (250)       /* [ms,1] Clip of the frame delta (after inspection etc.) */
+
+#if (LMCTL_OLED_FPS < 4) || (LMCTL_OLED_FPS > 30)
+#error "LMCTL_OLED_FPS (luminous_config.h) must be within 4 ~ 30"
+#endif
 
 #define Y_LMCTL_STATE_INIT      (0x00)      /* Initialization state (t = 0)                           */
 #define Y_LMCTL_STATE_STARTUP   (0x01)      /* Startup state (t < Y_LMCTL_STARTUP_TIME)               */
 #define Y_LMCTL_STATE_IGNITION  (0x02)      /* Ignition state (t = Y_LMCTL_STARTUP_TIME)              */
 #define Y_LMCTL_STATE_RUNNING   (0x03)      /* Running state (t > Y_LMCTL_STARTUP_TIME)               */
+#define Y_LMCTL_STATE_IDLE      (0x04)      /* Idle state (no key event for Y_LMCTL_IDLE_TIME)        */
+#define Y_LMCTL_STATE_SLEEP     (0x05)      /* Sleep state (no key event for Y_LMCTL_SLEEP_TIME)      */
+
+#define Y_LMCTL_IDLE_TIME       (10000)     /* [ms,1] 10s  (below OLED_TIMEOUT)                       */
+#define Y_LMCTL_SLEEP_TIME      (30000)     /* [ms,1] 30s  (below OLED_TIMEOUT)                       */
+#define Y_LMCTL_IDLE_FRAME_TIME (100)       /* [ms,1] Luminous frame interval in the idle state       */
+#define Y_LMCTL_SLEEP_FRAME_TIME (500)      /* [ms,1] Luminous frame interval in the sleep state      */
+#define Y_LMCTL_OLED_DIM_BRIGHTNESS (16)    /* OLED brightness in the idle state                      */
+#define Y_LMCTL_OLED_DIM_TIME   (1000)      /* [ms,1] Fade to the idle brightness                     */
+
+#define Y_LMCTL_STACK_CANARY    (0xC5)      /* Pattern painted over the free SRAM at boot             */
 
 #define Y_LMCTL_LAYER_BASE      (0x00)      /* Base layer                                             */
 #define Y_LMCTL_LAYER_LOWER     (Y_BIT1)    /* Lower layer                                            */
 #define Y_LMCTL_LAYER_RAISE     (Y_BIT2)    /* Raise layer                                            */
 #define Y_LMCTL_LAYER_ADJUST    (Y_BIT3)    /* Adjust layer                                           */
 
-#ifdef OLED_DRIVER_ENABLE
+#if (OLED_DRIVER_ENABLE == 1)
 #define Y_LMCTL_OLED_COL_NUM    (128)       /* Number of columns for the OLED display                 */
 #define Y_LMCTL_OLED_ROW_NUM    (4)         /* Number of rows for the OLED display (32 / 8 = 4)       */
-#define Y_LMCTL_OLED_UPDATE_INTERVAL (1)    /* [ms,64] 64 * 1 =  64ms                                 */
+#define Y_LMCTL_EFFECT_STEP_MAX (4)         /* [step] Upper limit of the effect steps per frame       */
+#define Y_LMCTL_1501_STEP_RATE  (8)         /* [step/s] (#1501) Labyrinth carving speed               */
+#define Y_LMCTL_1501_STACK_SIZE (400)       /* (#1501) Labyrinth point stack depth                    */
+#define Y_LMCTL_1502_STEP_RATE  (10)        /* [gen/s] (#1502) Life speed                             */
+#define Y_LMCTL_1502_GEN_MAX    (1000)      /* [gen] (#1502) Reseed after this many generations       */
 
 #define Y_LMCTL_OLED_NO_DIR     (0)         /* No direction                                           */
 #define Y_LMCTL_OLED_UP         (1)         /* Up direction                                           */
@@ -89,102 +123,148 @@ typedef struct {
 
 #define Y_LMCTL_OLED_STACK_EMPTY    (0)     /* Empty stack index                                      */
 
+#define Y_LMCTL_1301_X          (1)         /* [px] (#1301) Layer overlay position (5 glyphs wide)    */
+#define Y_LMCTL_1301_Y          (0)         /* [px] (#1301) Layer overlay position                    */
+#define Y_LMCTL_1301_LEN        (5)         /* [char] (#1301) Layer overlay length                    */
+#define Y_LMCTL_1200_FADE_TIME  (512)       /* [ms,1] (#1200) Logo fade out / effect fade in          */
+#define Y_LMCTL_1510_X          (1)         /* [px] (#1510) Effect name ticker position               */
+#define Y_LMCTL_1510_Y          (52)        /* [px] (#1510) Effect name ticker position (first line)  */
+#define Y_LMCTL_1510_LEN        (5)         /* [char] (#1510) Glyphs per line                         */
+#define Y_LMCTL_1510_TIME       (2000)      /* [ms,1] (#1510) Effect name ticker time                 */
+
 #endif /* OLED_DRIVER_ENABLE */
 
 /********************************************************************************************************************************/
 /*  Macros                                                                                                                      */
 /********************************************************************************************************************************/
-#ifdef OLED_DRIVER_ENABLE
-
-/****************************************************************/
-/* OLED Buffer Write Macro                                      */
-/****************************************************************/
-/* Example:                                                     */
-/* const static uint8_t Xuc_oled_buffer[Y_LMCTL_OLED_COL_NUM][Y_LMCTL_OLED_ROW_NUM] = {
- *              {0b00000000, 0b00000000, 0b00000000, 0b00000000},
- *              {0b00111000, 0b00000000, 0b00000000, 0b00000000},
- *              {0b01000100, 0b00000000, 0b00000000, 0b00000000},
- *              {0b01111100, 0b00000000, 0b00000000, 0b00000000},
- *              {0b01000100, 0b00000000, 0b00000000, 0b00000000},
- *              {0b01000100, 0b00000000, 0b00000000, 0b00000000},
- *              {0b00000000, 0b00000000, 0b00000000, 0b00000000},
- *              {0b00000000, 0b01111000, 0b00000000, 0b00000000},
- *              {0b00000000, 0b01000100, 0b00000000, 0b00000000},
- *              {0b00000000, 0b01111000, 0b00000000, 0b00000000},
- *              {0b00000000, 0b01000100, 0b00000000, 0b00000000},
- *              {0b00000000, 0b01111000, 0b00000000, 0b00000000},
- *              {0b00000000, 0b00000000, 0b00000000, 0b00000000},
- *              {0b00000000, 0b00000000, 0b00111000, 0b00000000},
- *              {0b00000000, 0b00000000, 0b01000100, 0b00000000},
- *              {0b00000000, 0b00000000, 0b01000000, 0b00000000},
- *              {0b00000000, 0b00000000, 0b01000100, 0b00000000},
- *              {0b00000000, 0b00000000, 0b00111000, 0b00000000},
- *              {0b00000000, 0b00000000, 0b00000000, 0b00000000},
- *              {0b00000000, 0b00000000, 0b00000000, 0b01111000},
- *              {0b00000000, 0b00000000, 0b00000000, 0b01000100},
- *              {0b00000000, 0b00000000, 0b00000000, 0b01000100},
- *              {0b00000000, 0b00000000, 0b00000000, 0b01000100},
- *              {0b00000000, 0b00000000, 0b00000000, 0b01111000},
- *              {0b00000000, 0b00000000, 0b00000000, 0b00000000},
- *              ...
- * };
- * 
- * This macro writes the buffer to the OLED display.
- *     +----+
- *     |    |
- *     |A   |
- *     | B  |
- *     |  C |
- *     |   D|
- *     ...
- * 
- */
-#define M_LMCTL_OLED_WRITE_BUFFER(puc_buffer)   { \
-    uint16_t us_WRITE_BUFFER_idx = 0; \
-    for (uint16_t us_WRITE_BUFFER_row_i = 0; us_WRITE_BUFFER_row_i < Y_LMCTL_OLED_ROW_NUM; us_WRITE_BUFFER_row_i++) { \
-        for (uint16_t us_WRITE_BUFFER_col_i = Y_LMCTL_OLED_COL_NUM; us_WRITE_BUFFER_col_i != 0; us_WRITE_BUFFER_col_i--) { \
-            uint8_t uc_WRITE_BUFFER_tmp = puc_buffer[us_WRITE_BUFFER_col_i-1][us_WRITE_BUFFER_row_i]; \
-            M_REVERSE_BIT_8(uc_WRITE_BUFFER_tmp); \
-            oled_write_raw_byte(uc_WRITE_BUFFER_tmp, us_WRITE_BUFFER_idx); \
-            us_WRITE_BUFFER_idx++; \
-        } \
-    } \
-}
-
-#define M_LMCTL_OLED_TRANSFER_BUFFER(puc_from, puc_to)   { \
-    for (uint16_t us_TRANSFER_BUFFER_row_i = 0; us_TRANSFER_BUFFER_row_i < Y_LMCTL_OLED_ROW_NUM; us_TRANSFER_BUFFER_row_i++) { \
-        for (uint16_t us_TRANSFER_BUFFER_col_i = 0; us_TRANSFER_BUFFER_col_i < Y_LMCTL_OLED_COL_NUM; us_TRANSFER_BUFFER_col_i++) { \
-            puc_to[us_TRANSFER_BUFFER_col_i][us_TRANSFER_BUFFER_row_i] = puc_from[us_TRANSFER_BUFFER_col_i][us_TRANSFER_BUFFER_row_i]; \
-        } \
-    } \
-}
-
-#define M_LMCTL_OLED_SET_BIT(puc_buffer, uc_x, uc_y)   { \
-    uint16_t us_OLED_SET_BIT_byte_idx = uc_x / 8; \
-    uint8_t uc_OLED_SET_BIT_bit_idx = uc_x % 8; \
-    puc_buffer[uc_y][us_OLED_SET_BIT_byte_idx] |= (1U << (7 - uc_OLED_SET_BIT_bit_idx)); \
-}
-
-#define M_LMCTL_OLED_CLEAR_BIT(puc_buffer, uc_x, uc_y)   { \
-    uint16_t us_OLED_CLEAR_BIT_byte_idx = uc_x / 8; \
-    uint8_t uc_OLED_CLEAR_BIT_bit_idx = uc_x % 8; \
-    puc_buffer[uc_y][us_OLED_CLEAR_BIT_byte_idx] &= ~(1U << (7 - uc_OLED_CLEAR_BIT_bit_idx)); \
-}
-
-#define M_LMCTL_OLED_GET_BIT(puc_buffer, uc_x, uc_y)   ((puc_buffer[uc_y][uc_x / 8] & (1U << (7 - uc_x % 8))) ? 1 : 0)
+/****************************************************************/
+/* Step Rate Macro                                              */
+/****************************************************************/
+/* Converts a speed in [step/s] to the fixed-point [step/ms]    */
+/* (Q16) added to a step accumulator, see m_lmctl_step_accumulate.
+ *     e.g. M_LMCTL_STEP_RATE(8) = (8 << 16) / 1000 = 524       */
+/****************************************************************/
+#define Y_LMCTL_STEP_Q          (16)        /* Fraction bits of the step accumulators                 */
+#define M_LMCTL_STEP_RATE(steps_per_sec)    ((uint32_t)(((uint32_t)(steps_per_sec) << Y_LMCTL_STEP_Q) / 1000U))
+
+#if (OLED_DRIVER_ENABLE == 1)
+
+/****************************************************************/
+/* OLED Buffer Access Macros                                    */
+/****************************************************************/
+/* The effects draw straight into the buffer of the OLED        */
+/* driver, seen as a portrait canvas:                           */
+/*     x: 0 ~ (Y_LMCTL_OLED_ROW_NUM * 8 - 1)   (across, 32px)   */
+/*     y: 0 ~ (Y_LMCTL_OLED_COL_NUM - 1)       (down, 128px)    */
+/* Pixel (x, y) is bit (x % 8) of the driver byte               */
+/*     (x / 8) * Y_LMCTL_OLED_COL_NUM + (Y_LMCTL_OLED_COL_NUM - 1 - y)
+ * Writes go through oled_write_raw_byte(), which marks only    */
+/* the touched blocks dirty for the next flush.                 */
+/****************************************************************/
+#define M_LMCTL_OLED_BUFFER()   ((const uint8_t *)oled_read_raw(0).current_element)
+
+#define M_LMCTL_OLED_INDEX(uc_x, uc_y)  \
+    ((uint16_t)((uc_x) / 8) * Y_LMCTL_OLED_COL_NUM + (Y_LMCTL_OLED_COL_NUM - 1 - (uc_y)))
+
+#define M_LMCTL_OLED_MASK(uc_x)         ((uint8_t)(1U << ((uc_x) % 8)))
+
+#define M_LMCTL_OLED_SET_BIT(uc_x, uc_y)   { \
+    uint16_t us_OLED_SET_BIT_idx = M_LMCTL_OLED_INDEX(uc_x, uc_y); \
+    oled_write_raw_byte(M_LMCTL_OLED_BUFFER()[us_OLED_SET_BIT_idx] | M_LMCTL_OLED_MASK(uc_x), us_OLED_SET_BIT_idx); \
+}
+
+#define M_LMCTL_OLED_CLEAR_BIT(uc_x, uc_y)   { \
+    uint16_t us_OLED_CLEAR_BIT_idx = M_LMCTL_OLED_INDEX(uc_x, uc_y); \
+    oled_write_raw_byte(M_LMCTL_OLED_BUFFER()[us_OLED_CLEAR_BIT_idx] & ~M_LMCTL_OLED_MASK(uc_x), us_OLED_CLEAR_BIT_idx); \
+}
+
+#define M_LMCTL_OLED_GET_BIT(uc_x, uc_y)   ((M_LMCTL_OLED_BUFFER()[M_LMCTL_OLED_INDEX(uc_x, uc_y)] & M_LMCTL_OLED_MASK(uc_x)) ? 1 : 0)
+
+#define M_LMCTL_1501_RAM        (zun_LMCTL_effect_arena.st_1501)    /* (#1501) Labyrinth RAM in the effect arena */
+#define M_LMCTL_1502_RAM        (zun_LMCTL_effect_arena.st_1502)    /* (#1502) Life RAM in the effect arena      */
+
+/****************************************************************/
+/* OLED Row Word Macros                                         */
+/****************************************************************/
+/* Canvas row y (32 pixels across) is one byte in each of the   */
+/* 4 pages of driver column (Y_LMCTL_OLED_COL_NUM - 1 - y), so  */
+/* it packs into a uint32_t with pixel x at bit x.              */
+/****************************************************************/
+#define M_LMCTL_OLED_GET_ROW(puc_oled, us_col)  \
+    (  (uint32_t)(puc_oled)[(us_col)] \
+     | ((uint32_t)(puc_oled)[(us_col) + Y_LMCTL_OLED_COL_NUM] << 8) \
+     | ((uint32_t)(puc_oled)[(us_col) + Y_LMCTL_OLED_COL_NUM * 2] << 16) \
+     | ((uint32_t)(puc_oled)[(us_col) + Y_LMCTL_OLED_COL_NUM * 3] << 24))
+
+#define M_LMCTL_OLED_SET_ROW(us_col, ul_row)   { \
+    oled_write_raw_byte((uint8_t)(ul_row), (us_col)); \
+    oled_write_raw_byte((uint8_t)((ul_row) >> 8), (us_col) + Y_LMCTL_OLED_COL_NUM); \
+    oled_write_raw_byte((uint8_t)((ul_row) >> 16), (us_col) + Y_LMCTL_OLED_COL_NUM * 2); \
+    oled_write_raw_byte((uint8_t)((ul_row) >> 24), (us_col) + Y_LMCTL_OLED_COL_NUM * 3); \
+}
+
+#define M_LMCTL_ROTL32(ul_x)    (((ul_x) << 1) | ((ul_x) >> 31))
+#define M_LMCTL_ROTR32(ul_x)    (((ul_x) >> 1) | ((ul_x) << 31))
 
 #endif /* OLED_DRIVER_ENABLE */
 
 /********************************************************************************************************************************/
 /*  Structures                                                                                                                  */
 /********************************************************************************************************************************/
-#ifdef OLED_DRIVER_ENABLE
+#if (OLED_DRIVER_ENABLE == 1)
 
 typedef struct {
     uint8_t uc_x;          /* X coordinate    */
     uint8_t uc_y;          /* Y coordinate    */
 } lmctl_point_t;           /* Point           */
 
+/****************************************************************/
+/* Idle effect descriptor                                       */
+/****************************************************************/
+/* pf_init   : start (or restart) the effect                    */
+/* pf_step   : advance by up to <budget> steps,                 */
+/*             returns Y_ON when finished (then restarted)      */
+/* pf_render : draw into the OLED driver buffer, or NULL when   */
+/*             the effect draws while stepping                  */
+/* Any hook may be NULL.                                        */
+/****************************************************************/
+typedef struct {
+    void (*pf_init)(void);              /* Init hook                                    */
+    uint8_t (*pf_step)(uint8_t uc_budget);  /* Step hook                                */
+    void (*pf_render)(void);            /* Render hook                                  */
+    uint8_t uc_step_rate;               /* [step/s] Speed                               */
+    uint16_t us_ram_size;               /* [byte] Static RAM taken in the effect arena  */
+    const char *pc_name;                /* Name (PROGMEM)                               */
+} lmctl_effect_t;
+
+#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
+typedef struct {
+    uint8_t uc_point_stack_x[Y_LMCTL_1501_STACK_SIZE];     /* Point stack x            */
+    uint8_t uc_point_stack_y[Y_LMCTL_1501_STACK_SIZE];     /* Point stack y            */
+    uint16_t us_point_stack_idx;                            /* Point stack index        */
+} lmctl_1501_ram_t;                                         /* (#1501) Labyrinth RAM    */
+#endif /* LMCTL_1501_LABYRINTH_ENABLE */
+
+#if (LMCTL_1502_LIFE_ENABLE == 1)
+typedef struct {
+    uint16_t us_generation;                                 /* Generations since seeded */
+} lmctl_1502_ram_t;                                         /* (#1502) Life RAM         */
+#endif /* LMCTL_1502_LIFE_ENABLE */
+
+/****************************************************************/
+/* Effect arena: only one effect runs at a time, so the RAM of  */
+/* all the selected effects is overlaid.                        */
+/****************************************************************/
+typedef union {
+#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
+    lmctl_1501_ram_t st_1501;           /* (#1501) Labyrinth                            */
+#endif /* LMCTL_1501_LABYRINTH_ENABLE */
+#if (LMCTL_1502_LIFE_ENABLE == 1)
+    lmctl_1502_ram_t st_1502;           /* (#1502) Life                                 */
+#endif /* LMCTL_1502_LIFE_ENABLE */
+    uint8_t uc_none;                    /* No effect with RAM selected                  */
+} lmctl_effect_arena_t;
+
 #endif /* OLED_DRIVER_ENABLE */
 
 /********************************************************************************************************************************/
@@ -203,71 +283,203 @@ const static char Xc_LMCTL_qmk_code_to_char[57][4] = {
 static layer_state_t zus_LMCTL_layer_state = Y_LMCTL_LAYER_BASE;    /* [-,-] Layer state for the luminous control    */
 static uint16_t zus_LMCTL_last_keycode = 0;                         /* [-,-] Last keycode                            */
 static uint8_t zuc_LMCTL_insp_mode_flg = Y_OFF;                     /* [-,-] Inspection mode flag                    */
+static uint32_t zul_LMCTL_last_record_time = 0;                     /* [ms,1] Timestamp of the last key event        */
+static uint16_t zus_LMCTL_frame_time = 0;                           /* [ms,1] Luminous frame interval (0: every one) */
 
-#ifdef OLED_DRIVER_ENABLE
-static uint8_t zuc_LMCTL_oled_raw_buffer[Y_LMCTL_OLED_COL_NUM][Y_LMCTL_OLED_ROW_NUM] = {0}; /* [-,-] OLED raw buffer */
+#if (OLED_DRIVER_ENABLE == 1)
+static uint8_t zuc_LMCTL_oled_redraw_req = Y_OFF;                   /* [-,-] Clear the OLED and restart the effects  */
+static uint8_t zuc_LMCTL_ticker_req = Y_OFF;                        /* [-,-] Scroll the name of the new effect       */
+static uint8_t zuc_LMCTL_effect_idx = 0;                            /* [-,-] Selected idle effect                    */
+static uint8_t zuc_LMCTL_effect_init_req = Y_ON;                    /* [-,-] Idle effect to be (re)started           */
+static uint32_t zul_LMCTL_effect_accumulator = 0;                   /* [step,Q16] Idle effect step accumulator       */
+static lmctl_effect_arena_t zun_LMCTL_effect_arena;                 /* [-,-] RAM of the running idle effect          */
+#if (LMCTL_1502_LIFE_ENABLE == 1) && defined(LMCTL_1502_MEASURE_CYCLES)
+static uint32_t zul_lmctl_1502_cycles_last = 0;                     /* [cycle] (#1502) Last generation               */
+static uint32_t zul_lmctl_1502_cycles_max = 0;                      /* [cycle] (#1502) Slowest generation            */
+#endif /* LMCTL_1502_MEASURE_CYCLES */
+#endif /* OLED_DRIVER_ENABLE */
 
-#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
-// static lmctl_point_t zst_lmctl_1501_point_stack[Y_LMCTL_OLED_COL_NUM * Y_LMCTL_OLED_ROW_NUM] = {0};    /* Point stack              */
-static uint8_t zuc_lmctl_1501_point_stack_x[400] = {0};           /* Point stack x            */
-static uint8_t zuc_lmctl_1501_point_stack_y[400] = {0};           /* Point stack y            */
-static uint16_t zus_lmctl_1501_point_stack_idx = Y_LMCTL_OLED_STACK_EMPTY;                                /* Point stack index        */
-// static uint8_t zuc_lmctl_1501_labyrinth[Y_LMCTL_OLED_COL_NUM][Y_LMCTL_OLED_ROW_NUM] = {0};             /* Labyrinth                */
-#endif /* LMCTL_1501_LABYRINTH_ENABLE */
+/********************************************************************************************************************************/
+/*  SRAM budget                                                                                                                 */
+/*                                                                                                                              */
+/*  Static buffers of the luminous control, checked against LMCTL_SRAM_BUDGET (luminous_config.h) at compile time.              */
+/*  The effects draw into the buffer of the OLED driver, which is not counted here.                                             */
+/********************************************************************************************************************************/
+#if (OLED_DRIVER_ENABLE == 1)
+#define Y_LMCTL_SRAM_EFFECT     (sizeof(zun_LMCTL_effect_arena))                    /* [byte] Idle effect arena       */
+#else
+#define Y_LMCTL_SRAM_EFFECT     (0)
 #endif /* OLED_DRIVER_ENABLE */
 
+#define Y_LMCTL_SRAM_USAGE      (Y_LMCTL_SRAM_EFFECT)                               /* [byte] Total                   */
+
+_Static_assert(Y_LMCTL_SRAM_USAGE <= LMCTL_SRAM_BUDGET,
+               "Luminous control buffers exceed LMCTL_SRAM_BUDGET (luminous_config.h)");
+
 /********************************************************************************************************************************/
 /*  Functions                                                                                                                   */
 /********************************************************************************************************************************/
 static void m_lmctl_data_latch_main(void);
+static uint8_t m_lmctl_step_accumulate(uint32_t *pul_accumulator, uint16_t us_delta_time, uint32_t ul_step_rate);
 static void m_lmctl_100_context_management(lmctl_context_t *pst_lmctl_context);
 static void m_lmctl_101_judge_state(lmctl_context_t *pst_lmctl_context);
+static void m_lmctl_102_power_management(const lmctl_context_t *pst_lmctl_context);
 
-#ifdef OLED_DRIVER_ENABLE
+#if (OLED_DRIVER_ENABLE == 1)
 static void m_lmctl_oled_main(const lmctl_context_t *pst_lmctl_context);
 static void m_lmctl_oled_main_insp(const lmctl_context_t *pst_lmctl_context);
 static void m_lmctl_1200_oled_startup_logo(const lmctl_context_t *pst_lmctl_context);
+#if (LMCTL_1201_BOOT_ANIM_ENABLE == 1)
+static void m_lmctl_1201_oled_boot_anim(const lmctl_context_t *pst_lmctl_context);
+#endif /* LMCTL_1201_BOOT_ANIM_ENABLE */
 static void m_lmctl_1300_oled_current_layer(const lmctl_context_t *pst_lmctl_context);
+static void m_lmctl_1301_oled_layer_overlay(const lmctl_context_t *pst_lmctl_context);
 static void m_lmctl_1500_oled_idle_management(const lmctl_context_t *pst_lmctl_context);
+static uint8_t m_lmctl_1510_oled_effect_ticker(const lmctl_context_t *pst_lmctl_context);
 #if (LMCTL_1501_LABYRINTH_ENABLE == 1)
-static bool m_lmctl_1501_oled_generate_labirynth(const lmctl_context_t *pst_lmctl_context);
 static void m_lmctl_1501_oled_generate_labirynth_init(void);
+static uint8_t m_lmctl_1501_oled_generate_labirynth_step(uint8_t uc_budget);
 static uint8_t m_lmctl_1501_oled_generate_labirynth_update(void);
 #endif /* LMCTL_1501_LABYRINTH_ENABLE */
+#if (LMCTL_1502_LIFE_ENABLE == 1)
+static void m_lmctl_1502_oled_life_init(void);
+static uint8_t m_lmctl_1502_oled_life_step(uint8_t uc_budget);
+static uint8_t m_lmctl_1502_oled_life_generation(void);
+#ifdef LMCTL_1502_MEASURE_CYCLES
+static void m_lmctl_1602_oled_insp_life(void);
+#endif /* LMCTL_1502_MEASURE_CYCLES */
+#endif /* LMCTL_1502_LIFE_ENABLE */
 // static void m_lmctl_oled_init_by_frame(uint8_t puc_buffer[][Y_LMCTL_OLED_ROW_NUM], uint8_t uc_odd_size_flg);
 
 #if (LMCTL_1501_LABYRINTH_ENABLE == 1)  /* or ... */
-static void m_lmctl_oled_init_by_fill(uint8_t puc_buffer[][Y_LMCTL_OLED_ROW_NUM]);
+static void m_lmctl_oled_init_by_fill(uint8_t uc_data);
+#endif /* LMCTL_1501_LABYRINTH_ENABLE */
+static void m_lmctl_1600_oled_insp_stack(void);
+static void m_lmctl_1601_oled_insp_effect(void);
+#ifdef KEYTRACE_ENABLE
+static void m_lmctl_1603_oled_insp_chatter(void);
+#endif /* KEYTRACE_ENABLE */
+static void m_lmctl_oled_redraw(void);
+static void m_lmctl_oled_draw_char(uint8_t uc_x, uint8_t uc_y, char c_char);
+static uint8_t m_lmctl_oled_draw_text_P(uint8_t uc_x, uint8_t uc_y, const char *pc_text);
+
+#endif /* OLED_DRIVER_ENABLE */
+
+/********************************************************************************************************************************/
+/*  Idle effect registry                                                                                                        */
+/*                                                                                                                              */
+/*  One line per effect, selected at build time in luminous_config.h. Unselected effects are not referenced and cost no flash.  */
+/*  LM_NEXT rotates through the table at runtime, the selection is kept in the luminous settings (luminous_store.c).            */
+/********************************************************************************************************************************/
+#if (OLED_DRIVER_ENABLE == 1)
+#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
+static const char PROGMEM Xc_LMCTL_1501_name[] = "Labyrinth";
+#endif /* LMCTL_1501_LABYRINTH_ENABLE */
+#if (LMCTL_1502_LIFE_ENABLE == 1)
+static const char PROGMEM Xc_LMCTL_1502_name[] = "Life";
+#endif /* LMCTL_1502_LIFE_ENABLE */
+static const char PROGMEM Xc_LMCTL_none_name[] = "None";
+
+static const lmctl_effect_t PROGMEM Xst_LMCTL_effects[] = {
+/*    init                                          step                                          render  rate                     RAM                       name                  */
+#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
+    { m_lmctl_1501_oled_generate_labirynth_init,    m_lmctl_1501_oled_generate_labirynth_step,    NULL,   Y_LMCTL_1501_STEP_RATE,  sizeof(lmctl_1501_ram_t), Xc_LMCTL_1501_name },
 #endif /* LMCTL_1501_LABYRINTH_ENABLE */
+#if (LMCTL_1502_LIFE_ENABLE == 1)
+    { m_lmctl_1502_oled_life_init,                  m_lmctl_1502_oled_life_step,                  NULL,   Y_LMCTL_1502_STEP_RATE,  sizeof(lmctl_1502_ram_t), Xc_LMCTL_1502_name },
+#endif /* LMCTL_1502_LIFE_ENABLE */
+    { NULL,                                         NULL,                                         NULL,   0,                       0,                        Xc_LMCTL_none_name },
+};
 
+#define Y_LMCTL_EFFECT_NUM      (sizeof(Xst_LMCTL_effects) / sizeof(Xst_LMCTL_effects[0]))     /* Number of idle effects */
 #endif /* OLED_DRIVER_ENABLE */
 
+#if defined(__AVR__)
+void m_lmctl_stack_paint(void) __attribute__((naked, used, section(".init1")));
+static uint16_t m_lmctl_stack_unused(void);
+static uint16_t m_lmctl_adc_noise(void);
+#endif /* __AVR__ */
+
+/****************************************************************/
+/*  m_lmctl_init                                                */
+/*--------------------------------------------------------------*/
+/*  Restore the luminous settings from the EEPROM.              */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init                                  */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmctl_init(void) {
+    lmsto_settings_t *pst_settings;                             /* Luminous settings        */
+
+    m_lmsto_init();                                             /* Read the EEPROM log      */
+    pst_settings = m_lmsto_settings();
+
+    if (pst_settings->uc_insp_mode_flg == Y_ON) {
+        zuc_LMCTL_insp_mode_flg = Y_ON;                         /* Inspection mode ON       */
+    } else {
+        zuc_LMCTL_insp_mode_flg = Y_OFF;                        /* Inspection mode OFF      */
+    }
+
+#if (OLED_DRIVER_ENABLE == 1)
+    if (pst_settings->uc_effect_id < Y_LMCTL_EFFECT_NUM) {
+        zuc_LMCTL_effect_idx = pst_settings->uc_effect_id;      /* Last selected effect     */
+    }
+    m_lmhw_init();                                              /* Hardware OLED effects    */
+#endif /* OLED_DRIVER_ENABLE */
+
+#if defined(__AVR__)
+    srand(pst_settings->us_prng_seed ^ m_lmctl_adc_noise());    /* Different effects per boot */
+#else
+    srand(pst_settings->us_prng_seed);
+#endif /* __AVR__ */
+}
+
 /****************************************************************/
 /*  m_lmctl_main                                                */
 /*--------------------------------------------------------------*/
 /*  Main function for the luminous control.                     */
+/*  In the idle and sleep states the effects only step every    */
+/*  Y_LMCTL_*_FRAME_TIME; any input restores every frame.       */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters:                                                 */
 /*  Returns:                                                    */
 /****************************************************************/
 void m_lmctl_main(void) {
     static lmctl_context_t zst_lmctl_context = {0};             /* LMCTL_Context            */
+    static uint32_t zul_frame_time = 0;                         /* Timestamp of the last frame */
 
     m_lmctl_data_latch_main();                                  /* Data latch (main)        */
 
+#if (OLED_DRIVER_ENABLE == 1)
+    if (zuc_LMCTL_oled_redraw_req == Y_ON) {                    /* Inspection mode toggled  */
+        m_lmctl_oled_redraw();                                  /* Restart from a clean OLED */
+    }
+    m_lmhw_task();                                              /* Hardware OLED effects    */
+#endif /* OLED_DRIVER_ENABLE */
+
+    if ((zus_LMCTL_frame_time != 0)
+     && (last_input_activity_elapsed() >= Y_LMCTL_IDLE_TIME)
+     && (timer_elapsed32(zul_frame_time) < zus_LMCTL_frame_time)) {
+        return;                                                 /* Skip this frame (idle / sleep) */
+    }
+    zul_frame_time = timer_read32();
+
     if (zuc_LMCTL_insp_mode_flg == Y_ON) {                      /* Inspection mode          */
 
-#ifdef OLED_DRIVER_ENABLE
+#if (OLED_DRIVER_ENABLE == 1)
         m_lmctl_oled_main_insp(&zst_lmctl_context);             /* OLED Main (insp)         */
 #endif /* OLED_DRIVER_ENABLE */
         
     } else {                                                    /* Normal mode              */
         m_lmctl_100_context_management(&zst_lmctl_context);     /* (#100) Management        */
         m_lmctl_101_judge_state(&zst_lmctl_context);            /* (#101) Judge state       */
+        m_lmctl_102_power_management(&zst_lmctl_context);       /* (#102) Power management  */
 
-#ifdef OLED_DRIVER_ENABLE
+#if (OLED_DRIVER_ENABLE == 1)
         m_lmctl_oled_main(&zst_lmctl_context);                  /* OLED Main                */
 #endif /* OLED_DRIVER_ENABLE */
 
@@ -275,13 +487,121 @@ void m_lmctl_main(void) {
 
 }
 
+#if defined(__AVR__)
+/****************************************************************/
+/*  m_lmctl_stack_paint                                         */
+/*--------------------------------------------------------------*/
+/*  Paint the SRAM between the end of .bss and the top of the   */
+/*  stack with Y_LMCTL_STACK_CANARY.                            */
+/*  Runs from .init1, before the stack pointer is set up and    */
+/*  before .data / .bss are initialized, so it must not use     */
+/*  the stack.                                                  */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: reset                                               */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmctl_stack_paint(void) {
+    __asm__ volatile(
+        "    ldi r30, lo8(_end)     \n"
+        "    ldi r31, hi8(_end)     \n"
+        "    ldi r24, %0            \n"
+        "    ldi r25, hi8(__stack)  \n"
+        "    rjmp 2f                \n"
+        "1:  st Z+, r24             \n"
+        "2:  cpi r30, lo8(__stack)  \n"
+        "    cpc r31, r25           \n"
+        "    brlo 1b                \n"
+        "    breq 1b                \n"
+        :
+        : "M"(Y_LMCTL_STACK_CANARY)
+    );
+}
+
+/****************************************************************/
+/*  m_lmctl_stack_unused                                        */
+/*--------------------------------------------------------------*/
+/*  Count the bytes above .bss that were never touched since    */
+/*  reset (stack high-water mark).                              */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL (inspection mode)              */
+/*  Parameters:                                                 */
+/*  Returns: <uint16_t> [byte] Never used SRAM                  */
+/****************************************************************/
+static uint16_t m_lmctl_stack_unused(void) {
+    extern uint8_t _end;                                        /* End of .bss (linker)     */
+    extern uint8_t __stack;                                     /* Top of SRAM (linker)     */
+    const uint8_t *xpuc_p = &_end;
+    uint16_t us_unused = 0;
+
+    while ((xpuc_p <= &__stack) && (*xpuc_p == Y_LMCTL_STACK_CANARY)) {
+        xpuc_p++;
+        us_unused++;
+    }
+    return us_unused;
+}
+
+/****************************************************************/
+/*  m_lmctl_adc_noise                                           */
+/*--------------------------------------------------------------*/
+/*  Collect the LSB noise of the internal temperature sensor.   */
+/*  Seeds rand() differently on every boot without writing the  */
+/*  seed back to the EEPROM. The ADC is turned off afterwards.  */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init                                  */
+/*  Parameters:                                                 */
+/*  Returns: <uint16_t> Noise of 16 conversions                 */
+/****************************************************************/
+static uint16_t m_lmctl_adc_noise(void) {
+    uint16_t us_noise = 0;                                      /* Collected noise          */
+
+#if defined(MUX5)
+    uint8_t uc_i;                                               /* Loop counter             */
+
+    ADMUX = _BV(REFS1) | _BV(REFS0) | 0x07;                     /* 2.56V, temperature sensor */
+    ADCSRB = _BV(MUX5);                                         /*  (MUX 100111)            */
+    ADCSRA = _BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);  /* ADC on, F_CPU / 128      */
+    for (uc_i = 0; uc_i < 16; uc_i++) {
+        ADCSRA |= _BV(ADSC);                                    /* Start a conversion       */
+        while (ADCSRA & _BV(ADSC)) {
+        }
+        us_noise = (uint16_t)((us_noise << 1) | (us_noise >> 15)) ^ ADC;
+    }
+    ADCSRA = 0;                                                 /* ADC off                  */
+#else
+    us_noise = TCNT0;                                           /* No temperature sensor    */
+#endif /* MUX5 */
+    return us_noise;
+}
+#endif /* __AVR__ */
+
+/****************************************************************/
+/*  m_lmctl_housekeeping                                        */
+/*--------------------------------------------------------------*/
+/*  Writes the luminous settings back to the EEPROM.            */
+/*  The idle and sleep states lower the luminous frame rate in  */
+/*  m_lmctl_main instead of waiting here: the main loop keeps   */
+/*  USB, the split transport and the matrix scan at full rate.  */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: main loop                                           */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmctl_housekeeping(void) {
+    m_lmsto_task();                                             /* Settings write-back      */
+}
+
 /****************************************************************/
 /*  m_lmctl_data_latch_main                                     */
 /*--------------------------------------------------------------*/
 /*  Data latch function for the luminous control.               */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters:                                                 */
 /*  Returns:                                                    */
 /****************************************************************/
@@ -289,6 +609,28 @@ static void m_lmctl_data_latch_main(void) {
     zus_LMCTL_layer_state = layer_state;                       /* Update the layer state   */
 }
 
+/****************************************************************/
+/*  m_lmctl_step_accumulate                                     */
+/*--------------------------------------------------------------*/
+/*  Advance a fixed-point step accumulator by the frame delta   */
+/*  and take out the whole steps, so that the animation speed   */
+/*  does not depend on LMCTL_OLED_FPS.                          */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <Accumulator [step,Q16]>, <Delta [ms,1]>,       */
+/*              <Rate [step/ms,Q16]> (M_LMCTL_STEP_RATE)        */
+/*  Returns: <uint8_t> Whole steps due in this frame            */
+/****************************************************************/
+static uint8_t m_lmctl_step_accumulate(uint32_t *pul_accumulator, uint16_t us_delta_time, uint32_t ul_step_rate) {
+    uint32_t ul_accumulator = *pul_accumulator + (uint32_t)us_delta_time * ul_step_rate;
+    uint32_t ul_steps = ul_accumulator >> Y_LMCTL_STEP_Q;                      /* Whole steps              */
+
+    *pul_accumulator = ul_accumulator & ((1UL << Y_LMCTL_STEP_Q) - 1);         /* Keep the fraction        */
+
+    return (ul_steps > UINT8_MAX) ? UINT8_MAX : (uint8_t)ul_steps;
+}
+
 /****************************************************************/
 /*  m_lmctl_100_context_management                              */
 /*--------------------------------------------------------------*/
@@ -296,17 +638,34 @@ static void m_lmctl_data_latch_main(void) {
 /*      (Luminous Control #100)                                 */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
 /*  Returns:                                                    */
 /****************************************************************/
 static void m_lmctl_100_context_management(lmctl_context_t *pst_lmctl_context) {
-    uint32_t ul_app_timestamp = pst_lmctl_context->ul_app_timestamp;    /* [ms,64] System timestamp         */
+    const uint32_t xul_frame_time = timer_read32();                     /* [ms,1] Now                       */
+    uint32_t ul_app_timestamp = pst_lmctl_context->ul_app_timestamp;    /* [ms,1] System timestamp          */
+    uint32_t ul_delta_time;                                             /* [ms,1] Time since the last frame */
     uint8_t uc_master_mode_flg;                                         /* Master mode flag                 */
+    uint32_t ul_inactive_time;                                          /* [ms,1] Time since the last event */
 
     {
+        /* Frame delta          */
+        if (pst_lmctl_context->ul_frame_time == 0) {
+            ul_delta_time = 0;                                          /* First frame                      */
+        } else {
+            ul_delta_time = TIMER_DIFF_32(xul_frame_time, pst_lmctl_context->ul_frame_time);
+            if (ul_delta_time > Y_LMCTL_DELTA_TIME_MAX) {
+                ul_delta_time = Y_LMCTL_DELTA_TIME_MAX;                 /* Do not jump after a pause        */
+            }
+        }
+
         /* System timestamp     */
-        M_CLIP_INC(ul_app_timestamp, UINT32_MAX)                        /* Increment the system timestamp   */
+        if (ul_app_timestamp <= (UINT32_MAX - ul_delta_time)) {
+            ul_app_timestamp += ul_delta_time;                          /* Advance the system timestamp     */
+        } else {
+            ul_app_timestamp = UINT32_MAX;                              /* Clip                             */
+        }
 
         /* Master mode flag     */
         if (is_keyboard_master()) {
@@ -314,11 +673,21 @@ static void m_lmctl_100_context_management(lmctl_context_t *pst_lmctl_context) {
         } else {
             uc_master_mode_flg = Y_OFF;                                 /* Master mode flag OFF             */
         }
+
+        /* Inactive time        */
+        if (uc_master_mode_flg == Y_ON) {
+            ul_inactive_time = timer_elapsed32(zul_LMCTL_last_record_time);  /* Since m_lmctl_record   */
+        } else {
+            ul_inactive_time = last_input_activity_elapsed();           /* Synced from the master           */
+        }
     }
 
     pst_lmctl_context->ul_app_timestamp = ul_app_timestamp;             /* Update the system timestamp      */
+    pst_lmctl_context->ul_frame_time = xul_frame_time;                  /* Update the frame time            */
+    pst_lmctl_context->us_delta_time = (uint16_t)ul_delta_time;         /* Update the frame delta           */
     pst_lmctl_context->uc_master_mode_flg = uc_master_mode_flg;         /* Update the master mode flag      */
     pst_lmctl_context->us_layer_state = zus_LMCTL_layer_state;      /* Update the layer state           */
+    pst_lmctl_context->ul_inactive_time = ul_inactive_time;             /* Update the inactive time         */
 }
 
 /****************************************************************/
@@ -327,12 +696,14 @@ static void m_lmctl_100_context_management(lmctl_context_t *pst_lmctl_context) {
 /*  Judge the luminous control state.                           */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
 /*  Returns:                                                    */
 /****************************************************************/
 static void m_lmctl_101_judge_state(lmctl_context_t *pst_lmctl_context) {
-    const uint32_t xul_app_timestamp = pst_lmctl_context->ul_app_timestamp;     /* [ms,64] App timestamp     */
+    const uint32_t xul_app_timestamp = pst_lmctl_context->ul_app_timestamp;     /* [ms,1] App timestamp      */
+    const uint16_t xus_delta_time = pst_lmctl_context->us_delta_time;           /* [ms,1] Frame delta        */
+    const uint32_t xul_inactive_time = pst_lmctl_context->ul_inactive_time;     /* [ms,1] Inactive time      */
     uint8_t uc_lmctl_state;                                                     /* Luminous control state    */
 
     {
@@ -340,8 +711,12 @@ static void m_lmctl_101_judge_state(lmctl_context_t *pst_lmctl_context) {
             uc_lmctl_state = Y_LMCTL_STATE_INIT;                                /* Initialization state      */
         } else if (xul_app_timestamp < Y_LMCTL_STARTUP_TIME) {
             uc_lmctl_state = Y_LMCTL_STATE_STARTUP;                             /* Startup state             */
-        } else if (xul_app_timestamp == Y_LMCTL_STARTUP_TIME) {
-            uc_lmctl_state = Y_LMCTL_STATE_IGNITION;                            /* Ignition state            */
+        } else if ((xul_app_timestamp - xus_delta_time) < Y_LMCTL_STARTUP_TIME) {
+            uc_lmctl_state = Y_LMCTL_STATE_IGNITION;                            /* Ignition state (1 frame)  */
+        } else if (xul_inactive_time >= Y_LMCTL_SLEEP_TIME) {
+            uc_lmctl_state = Y_LMCTL_STATE_SLEEP;                               /* Sleep state               */
+        } else if (xul_inactive_time >= Y_LMCTL_IDLE_TIME) {
+            uc_lmctl_state = Y_LMCTL_STATE_IDLE;                                /* Idle state                */
         } else /* if (xul_app_timestamp > Y_LMCTL_STARTUP_TIME) */ {
             uc_lmctl_state = Y_LMCTL_STATE_RUNNING;                             /* Running state             */
         }
@@ -350,6 +725,64 @@ static void m_lmctl_101_judge_state(lmctl_context_t *pst_lmctl_context) {
     pst_lmctl_context->uc_lmctl_state = uc_lmctl_state;                         /* Update the system state   */
 }
 
+/****************************************************************/
+/*  m_lmctl_102_power_management                                */
+/*--------------------------------------------------------------*/
+/*  Dim / turn off the OLED and the RGB LEDs when entering the  */
+/*  idle / sleep states, restore them when leaving.             */
+/*      (Luminous Control #102)                                 */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <LMCTL_Context>                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_102_power_management(const lmctl_context_t *pst_lmctl_context) {
+    static uint8_t zuc_prev_state = Y_LMCTL_STATE_INIT;                         /* Previous state            */
+#ifdef RGBLIGHT_ENABLE
+    static uint8_t zuc_rgb_restore_flg = Y_OFF;                                 /* RGB to be re-enabled      */
+    const uint8_t xuc_master_mode_flg = pst_lmctl_context->uc_master_mode_flg;  /* Master mode flag          */
+#endif /* RGBLIGHT_ENABLE */
+    const uint8_t xuc_lmctl_state = pst_lmctl_context->uc_lmctl_state;          /* Luminous control state    */
+
+    if (xuc_lmctl_state != zuc_prev_state) {
+        if (xuc_lmctl_state == Y_LMCTL_STATE_IDLE) {
+            zus_LMCTL_frame_time = Y_LMCTL_IDLE_FRAME_TIME;                     /* Lower the frame rate      */
+#if (OLED_DRIVER_ENABLE == 1)
+            m_lmhw_fade(Y_LMCTL_OLED_DIM_BRIGHTNESS, Y_LMCTL_OLED_DIM_TIME);    /* Dim the OLED              */
+#endif /* OLED_DRIVER_ENABLE */
+        } else if (xuc_lmctl_state == Y_LMCTL_STATE_SLEEP) {
+            zus_LMCTL_frame_time = Y_LMCTL_SLEEP_FRAME_TIME;                    /* Lower the frame rate more */
+#if (OLED_DRIVER_ENABLE == 1)
+            oled_off();                                                         /* Turn off the OLED         */
+#endif /* OLED_DRIVER_ENABLE */
+#ifdef RGBLIGHT_ENABLE
+            if ((xuc_master_mode_flg == Y_ON) && rgblight_is_enabled()) {
+                rgblight_disable_noeeprom();                                    /* Turn off the RGB LEDs     */
+                zuc_rgb_restore_flg = Y_ON;                                     /*  (synced to the slave)    */
+            }
+#endif /* RGBLIGHT_ENABLE */
+        } else if ((zuc_prev_state == Y_LMCTL_STATE_IDLE)
+                || (zuc_prev_state == Y_LMCTL_STATE_SLEEP)) {
+            /* Wake up */
+            zus_LMCTL_frame_time = 0;                                           /* Full frame rate           */
+#if (OLED_DRIVER_ENABLE == 1)
+            m_lmhw_fade(OLED_BRIGHTNESS, 0);                                    /* Full brightness at once   */
+            oled_on();                                                          /* Unchanged buffer would not turn it on */
+#endif /* OLED_DRIVER_ENABLE */
+#ifdef RGBLIGHT_ENABLE
+            if (zuc_rgb_restore_flg == Y_ON) {
+                rgblight_enable_noeeprom();                                     /* Restore the RGB LEDs      */
+                zuc_rgb_restore_flg = Y_OFF;
+            }
+#endif /* RGBLIGHT_ENABLE */
+        } else {
+            /* Do nothing */
+        }
+        zuc_prev_state = xuc_lmctl_state;                                       /* Update the previous state */
+    }
+}
+
 #if (OLED_DRIVER_ENABLE == 1)
 /****************************************************************/
 /*  m_lmctl_oled_main                                           */
@@ -357,7 +790,7 @@ static void m_lmctl_101_judge_state(lmctl_context_t *pst_lmctl_context) {
 /*  Main function for the oled control.                         */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
 /*  Returns:                                                    */
 /****************************************************************/
@@ -365,7 +798,10 @@ static void m_lmctl_oled_main(const lmctl_context_t *pst_lmctl_context) {
     m_lmctl_1200_oled_startup_logo(pst_lmctl_context);                  /* (#1100) Startup logo display             */
     // m_lmctl_1300_oled_current_layer(pst_lmctl_context);                 /* (#1300) Current layer display            */
 
-    m_lmctl_1500_oled_idle_management(pst_lmctl_context);
+    if (m_lmctl_1510_oled_effect_ticker(pst_lmctl_context) == Y_OFF) {  /* (#1510) Effect name ticker               */
+        m_lmctl_1500_oled_idle_management(pst_lmctl_context);           /* (#1500) Idle management                  */
+        m_lmctl_1301_oled_layer_overlay(pst_lmctl_context);             /* (#1301) Layer over the effect            */
+    }
 }
 
 /****************************************************************/
@@ -374,7 +810,7 @@ static void m_lmctl_oled_main(const lmctl_context_t *pst_lmctl_context) {
 /*  Main function for the oled control in the inspection mode.  */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
 /*  Returns:                                                    */
 /****************************************************************/
@@ -382,7 +818,17 @@ static void m_lmctl_oled_main_insp(const lmctl_context_t *pst_lmctl_context) {
     const uint8_t xuc_master_mode_flg = pst_lmctl_context->uc_master_mode_flg;  /* Master mode flag           */
 
     oled_write_ln_P(PSTR("[Inspection]"), false);
-    
+    m_lmctl_1600_oled_insp_stack();                                     /* (#1600) Stack high-water mark            */
+    m_lmctl_1601_oled_insp_effect();                                    /* (#1601) Selected idle effect             */
+#if (LMCTL_1502_LIFE_ENABLE == 1) && defined(LMCTL_1502_MEASURE_CYCLES)
+    m_lmctl_1602_oled_insp_life();                                      /* (#1602) Life generation time             */
+#endif /* LMCTL_1502_MEASURE_CYCLES */
+#ifdef KEYTRACE_ENABLE
+    if (xuc_master_mode_flg == Y_ON) {
+        m_lmctl_1603_oled_insp_chatter();                               /* (#1603) Bounces (keytrace is master only)    */
+    }
+#endif /* KEYTRACE_ENABLE */
+
     if (xuc_master_mode_flg == Y_ON) {
         /* Master mode  */
         m_lmctl_1300_oled_current_layer(pst_lmctl_context);             /* (#1300) Current layer display            */
@@ -392,35 +838,186 @@ static void m_lmctl_oled_main_insp(const lmctl_context_t *pst_lmctl_context) {
     }
 }
 
+/****************************************************************/
+/*  m_lmctl_1600_oled_insp_stack                                */
+/*--------------------------------------------------------------*/
+/*  Display the SRAM never reached by the stack since reset.    */
+/*      (Luminous Control #1600)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL (inspection mode)              */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_1600_oled_insp_stack(void) {
+    oled_write_P(PSTR("Stack free:"), false);
+#if defined(__AVR__)
+    oled_write_ln(get_u16_str(m_lmctl_stack_unused(), ' '), false);    /* [byte] High-water margin */
+#else
+    oled_write_ln_P(PSTR("  n/a"), false);
+#endif /* __AVR__ */
+}
+
+/****************************************************************/
+/*  m_lmctl_1601_oled_insp_effect                               */
+/*--------------------------------------------------------------*/
+/*  Display the name of the selected idle effect.               */
+/*      (Luminous Control #1601)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL (inspection mode)              */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_1601_oled_insp_effect(void) {
+    oled_write_P(PSTR("Effect: "), false);
+    oled_write_ln_P((const char *)pgm_read_ptr(&Xst_LMCTL_effects[zuc_LMCTL_effect_idx].pc_name), false);
+}
+
+#if (LMCTL_1502_LIFE_ENABLE == 1) && defined(LMCTL_1502_MEASURE_CYCLES)
+/****************************************************************/
+/*  m_lmctl_1602_oled_insp_life                                 */
+/*--------------------------------------------------------------*/
+/*  Display the CPU cycles of the last and the slowest Life     */
+/*  generation, in kilocycles.                                  */
+/*      (Luminous Control #1602)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL (inspection mode)              */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_1602_oled_insp_life(void) {
+    oled_write_P(PSTR("Life kcyc:"), false);
+    oled_write(get_u16_str((uint16_t)(zul_lmctl_1502_cycles_last / 1000), ' '), false);
+    oled_write_P(PSTR(" max"), false);
+    oled_write_ln(get_u16_str((uint16_t)(zul_lmctl_1502_cycles_max / 1000), ' '), false);
+}
+#endif /* LMCTL_1502_MEASURE_CYCLES */
+
+#ifdef KEYTRACE_ENABLE
+/****************************************************************/
+/*  m_lmctl_1603_oled_insp_chatter                              */
+/*--------------------------------------------------------------*/
+/*  Display the bounces of the master half keys (lib/keytrace_  */
+/*  debounce.c, raw changes inside the debounce window): the    */
+/*  keys that bounced, the total count and the shortest time    */
+/*  from the window opening to a bounce. Then the re-presses    */
+/*  that got through debounce (pressed again within             */
+/*  KEYTRACE_REPRESS_MS of the release).                        */
+/*      (Luminous Control #1603)                                */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL (inspection mode)              */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_1603_oled_insp_chatter(void) {
+    const uint8_t xuc_min_gap = keytrace_bounce_min_gap();             /* [ms] 255: none                   */
+    keytrace_stats_t st_stats;                                          /* Statistics of one key            */
+    uint8_t uc_keys = 0;                                                /* Keys that bounced                */
+    uint16_t us_total = 0;                                              /* Bounce count of all keys         */
+    uint16_t us_repress = 0;                                            /* Re-press count of all keys       */
+    uint8_t uc_row;
+    uint8_t uc_col;
+
+    for (uc_row = 0; uc_row < MATRIX_ROWS; uc_row++) {
+        for (uc_col = 0; uc_col < MATRIX_COLS; uc_col++) {
+            keytrace_key_stats(uc_row, uc_col, &st_stats);
+            if (st_stats.bounce != 0) {
+                uc_keys++;
+                us_total += st_stats.bounce;
+            }
+            us_repress += st_stats.repress;
+        }
+    }
+
+    oled_write_P(PSTR("Bounce:"), false);
+    oled_write(get_u16_str(uc_keys, ' '), false);
+    oled_write_P(PSTR(" x"), false);
+    oled_write_ln(get_u16_str(us_total, ' '), false);
+    oled_write_P(PSTR("Gap ms:"), false);
+    if (xuc_min_gap == UINT8_MAX) {
+        oled_write_P(PSTR("    -"), false);
+    } else {
+        oled_write(get_u16_str(xuc_min_gap, ' '), false);
+    }
+    oled_write_P(PSTR(" Re:"), false);
+    oled_write_ln(get_u16_str(us_repress, ' '), false);
+}
+#endif /* KEYTRACE_ENABLE */
+
 /****************************************************************/
 /*  m_lmctl_1200_oled_startup_logo                              */
 /*--------------------------------------------------------------*/
-/*  Display the startup logo on the OLED.                       */
+/*  Display the startup logo on the OLED. The logo is dimmed    */
+/*  to contrast 0 before the ignition, which still shows it     */
+/*  faintly on the SSD1306, and cut by oled_clear() there.      */
 /*      (Luminous Control #1200)                                */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
 /*  Returns:                                                    */
 /*--------------------------------------------------------------*/
 /*  Requirements:  Declare the following in the keymap.c        */
 /*      - const char PROGMEM Xc_logo_indices[]                  */
+/*      - const uint8_t PROGMEM Xuc_boot_anim[]                 */
+/*          (LMCTL_1201_BOOT_ANIM_ENABLE == 1)                  */
 /****************************************************************/
 static void m_lmctl_1200_oled_startup_logo(const lmctl_context_t *pst_lmctl_context) {
     const uint8_t xuc_lmctl_state = pst_lmctl_context->uc_lmctl_state;  /* Luminous control state   */
+    const uint32_t xul_app_timestamp = pst_lmctl_context->ul_app_timestamp; /* [ms,1] App timestamp */
 
     {
         if ((xuc_lmctl_state == Y_LMCTL_STATE_INIT)
          || (xuc_lmctl_state == Y_LMCTL_STATE_STARTUP)) {
+#if (LMCTL_1201_BOOT_ANIM_ENABLE == 1)
+            m_lmctl_1201_oled_boot_anim(pst_lmctl_context);             /* (#1201) Boot animation   */
+#else
             oled_write_P(Xc_logo_indices, false);                       /* Display the logo         */
+#endif /* LMCTL_1201_BOOT_ANIM_ENABLE */
+            if (xul_app_timestamp >= (Y_LMCTL_STARTUP_TIME - Y_LMCTL_1200_FADE_TIME)) {
+                m_lmhw_fade(0, Y_LMCTL_1200_FADE_TIME);                 /* Dim the logo out         */
+            }
         } else if (xuc_lmctl_state == Y_LMCTL_STATE_IGNITION) {
-            oled_clear();                                               /* Clear the display        */
+#if (LMCTL_1201_BOOT_ANIM_ENABLE == 1)
+            m_lman_stop();                                              /* End of the boot animation */
+#endif /* LMCTL_1201_BOOT_ANIM_ENABLE */
+            oled_clear();                                               /* Cut the dimmed logo      */
+            m_lmhw_fade(OLED_BRIGHTNESS, Y_LMCTL_1200_FADE_TIME);       /* Fade the effect in       */
+            m_lmhw_shift(Y_ON);                                         /* Burn-in protection       */
         } else /* if (xuc_lmctl_state == Y_LMCTL_STATE_RUNNING) */ {
             /* Do nothing */                                            /* Do nothing               */
         }
     }
 }
 
+#if (LMCTL_1201_BOOT_ANIM_ENABLE == 1)
+/****************************************************************/
+/*  m_lmctl_1201_oled_boot_anim                                 */
+/*--------------------------------------------------------------*/
+/*  Play the boot animation instead of the static logo until    */
+/*  the ignition (luminous_anim.c).                             */
+/*      (Luminous Control #1201)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL (init / startup state)         */
+/*  Parameters: <LMCTL_Context>                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_1201_oled_boot_anim(const lmctl_context_t *pst_lmctl_context) {
+    static uint8_t zuc_started_flg = Y_OFF;                             /* Animation started        */
+
+    if (zuc_started_flg == Y_OFF) {
+        oled_clear();                                                   /* Frame 0 is drawn on black */
+        m_lman_start(Xuc_boot_anim);
+        zuc_started_flg = Y_ON;
+    } else {
+        (void)m_lman_task(pst_lmctl_context->us_delta_time);            /* Next frames when due     */
+    }
+}
+#endif /* LMCTL_1201_BOOT_ANIM_ENABLE */
+
 /****************************************************************/
 /*  m_lmctl_1300_oled_current_layer                             */
 /*--------------------------------------------------------------*/
@@ -428,7 +1025,7 @@ static void m_lmctl_1200_oled_startup_logo(const lmctl_context_t *pst_lmctl_cont
 /*      (Luminous Control #1300)                                */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
 /*  Returns:                                                    */
 /****************************************************************/
@@ -463,6 +1060,51 @@ static void m_lmctl_1300_oled_current_layer(const lmctl_context_t *pst_lmctl_con
     }
 }
 
+/****************************************************************/
+/*  m_lmctl_1301_oled_layer_overlay                             */
+/*--------------------------------------------------------------*/
+/*  Display the current layer over the idle effect with the     */
+/*  portrait font, while a layer other than the base is on.     */
+/*  Drawn after the effect in every frame, so the effect only   */
+/*  sees a fixed pattern where the text is.                     */
+/*      (Luminous Control #1301)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <LMCTL_Context>                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_1301_oled_layer_overlay(const lmctl_context_t *pst_lmctl_context) {
+    static uint8_t zuc_shown_flg = Y_OFF;                                   /* Overlay on the OLED      */
+    const uint16_t xus_layer_state = pst_lmctl_context->us_layer_state;     /* Layer state              */
+    const char *pc_name = NULL;                                             /* Layer name (PROGMEM)     */
+
+    if ((pst_lmctl_context->uc_master_mode_flg == Y_ON)
+     && (pst_lmctl_context->uc_lmctl_state == Y_LMCTL_STATE_RUNNING)) {
+        if ((xus_layer_state & Y_LMCTL_LAYER_ADJUST) != 0) {
+            pc_name = PSTR("Adjst");
+        } else if ((xus_layer_state & Y_LMCTL_LAYER_RAISE) != 0) {
+            pc_name = PSTR("Raise");
+        } else if ((xus_layer_state & Y_LMCTL_LAYER_LOWER) != 0) {
+            pc_name = PSTR("Lower");
+        } else {
+            /* Base layer: no overlay */
+        }
+    }
+
+    if (pc_name != NULL) {
+        (void)m_lmctl_oled_draw_text_P(Y_LMCTL_1301_X, Y_LMCTL_1301_Y, pc_name);
+        zuc_shown_flg = Y_ON;
+    } else if (zuc_shown_flg == Y_ON) {
+        for (uint8_t uc_i = 0; uc_i < Y_LMCTL_1301_LEN; uc_i++) {           /* Blank the overlay once   */
+            m_lmctl_oled_draw_char(Y_LMCTL_1301_X + uc_i * Y_LMFONT_WIDTH, Y_LMCTL_1301_Y, ' ');
+        }
+        zuc_shown_flg = Y_OFF;
+    } else {
+        /* Do nothing */
+    }
+}
+
 /****************************************************************/
 /*  m_lmctl_1500_oled_idle_management                           */
 /*--------------------------------------------------------------*/
@@ -470,62 +1112,109 @@ static void m_lmctl_1300_oled_current_layer(const lmctl_context_t *pst_lmctl_con
 /*      (Luminous Control #1500)                                */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
 /*  Returns:                                                    */
 /****************************************************************/
 static void m_lmctl_1500_oled_idle_management(const lmctl_context_t *pst_lmctl_context) {
     const uint8_t xuc_lmctl_state = pst_lmctl_context->uc_lmctl_state;      /* Luminous control state   */
+    lmctl_effect_t st_effect;                                               /* Selected effect          */
+    uint8_t uc_budget;                                                      /* Steps due in this frame  */
 
     if (xuc_lmctl_state == Y_LMCTL_STATE_RUNNING) {
-        /* Update idling actions   */
-#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
-        (void)m_lmctl_1501_oled_generate_labirynth(pst_lmctl_context);      /* (#1501) Generate labirynth   */
-#endif /* LMCTL_1501_LABYRINTH_ENABLE */
+        memcpy_P(&st_effect, &Xst_LMCTL_effects[zuc_LMCTL_effect_idx], sizeof(lmctl_effect_t));
+
+        /* Start the effect         */
+        if (zuc_LMCTL_effect_init_req == Y_ON) {
+            if (st_effect.pf_init != NULL) {
+                st_effect.pf_init();                                        /* Init hook                */
+            }
+            zul_LMCTL_effect_accumulator = 0;
+            zuc_LMCTL_effect_init_req = Y_OFF;
+        }
+
+        /* Advance the effect       */
+        uc_budget = m_lmctl_step_accumulate(
+            &zul_LMCTL_effect_accumulator,
+            pst_lmctl_context->us_delta_time,
+            M_LMCTL_STEP_RATE(st_effect.uc_step_rate)
+        );
+        if (uc_budget > Y_LMCTL_EFFECT_STEP_MAX) {
+            uc_budget = Y_LMCTL_EFFECT_STEP_MAX;                            /* Bound the work per frame */
+        }
+        if ((uc_budget != 0) && (st_effect.pf_step != NULL)) {
+            if (st_effect.pf_step(uc_budget) == Y_ON) {                     /* Step hook                */
+                zuc_LMCTL_effect_init_req = Y_ON;                           /* Finished: start over     */
+            }
+        }
 
-        /* Print to the OLED       */
-        M_LMCTL_OLED_WRITE_BUFFER(zuc_LMCTL_oled_raw_buffer);               /* Write the buffer to the OLED */
+        /* Draw the effect          */
+        if (st_effect.pf_render != NULL) {
+            st_effect.pf_render();                                          /* Render hook              */
+        }
     }
 }
 
-#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
 /****************************************************************/
-/*  m_lmctl_1501_oled_generate_labirynth                        */
+/*  m_lmctl_1510_oled_effect_ticker                             */
 /*--------------------------------------------------------------*/
-/*  Generate the labirynth on the OLED.                         */
-/*      (Luminous Control #1501)                                */
+/*  Show the name of a newly selected effect, scrolled by the   */
+/*  SSD1306 (no buffer transfer while it moves). The effect     */
+/*  starts over on a clean OLED when the ticker ends.           */
+/*      (Luminous Control #1510)                                */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <LMCTL_Context>                                 */
-/*  Returns: [bool]<true> if the action is completed            */
+/*  Returns: <uint8_t> Y_ON while the ticker owns the OLED      */
 /****************************************************************/
-static bool m_lmctl_1501_oled_generate_labirynth(const lmctl_context_t *pst_lmctl_context) {
-    static uint8_t zuc_initialize_req_flg = Y_ON;                   /* Initialized Request flag */
-    static uint8_t zuc_interval_counter = 0;                        /* Interval counter         */
-    static uint8_t zuc_end_flag = Y_OFF;                            /* End flag                 */
-
-    if (zuc_initialize_req_flg == Y_ON) {
-        /* Initialization   */
-        m_lmctl_1501_oled_generate_labirynth_init();                            /* Initialization    */
-        zuc_initialize_req_flg = Y_OFF;                                         /* Initialized request flag OFF */
-    }
-
-    if (zuc_interval_counter < Y_LMCTL_OLED_UPDATE_INTERVAL) {
-        /* Do nothing */
-        zuc_interval_counter++;                                                 /* Increment the interval counter */
+static uint8_t m_lmctl_1510_oled_effect_ticker(const lmctl_context_t *pst_lmctl_context) {
+    static uint8_t zuc_running_flg = Y_OFF;                                 /* Ticker on the OLED       */
+    const char *pc_name;                                                    /* Effect name (PROGMEM)    */
+    char c_char;                                                            /* Glyph to draw            */
+
+    if ((zuc_LMCTL_ticker_req == Y_ON)
+     && (pst_lmctl_context->uc_lmctl_state == Y_LMCTL_STATE_RUNNING)) {
+        pc_name = (const char *)pgm_read_ptr(&Xst_LMCTL_effects[zuc_LMCTL_effect_idx].pc_name);
+        c_char = pgm_read_byte(pc_name);
+        for (uint8_t uc_i = 0; c_char != '\0'; uc_i++) {                    /* Wrap per Y_LMCTL_1510_LEN */
+            m_lmctl_oled_draw_char(Y_LMCTL_1510_X + (uc_i % Y_LMCTL_1510_LEN) * Y_LMFONT_WIDTH,
+                                   Y_LMCTL_1510_Y + (uc_i / Y_LMCTL_1510_LEN) * Y_LMFONT_HEIGHT, c_char);
+            c_char = pgm_read_byte(++pc_name);
+        }
+        m_lmhw_ticker(Y_LMCTL_1510_TIME);
+        zuc_LMCTL_ticker_req = Y_OFF;
+        zuc_running_flg = Y_ON;
+    } else if ((zuc_running_flg == Y_ON) && (m_lmhw_scrolling() == Y_OFF)) {
+        zuc_LMCTL_oled_redraw_req = Y_ON;                                   /* Back to the effect       */
+        zuc_running_flg = Y_OFF;
     } else {
-        zuc_end_flag = m_lmctl_1501_oled_generate_labirynth_update();           /* Update the labirynth           */
-        zuc_interval_counter = 0;                                               /* Reset the interval counter     */
+        /* Do nothing */
     }
+    return zuc_running_flg;
+}
 
-    if (zuc_end_flag == Y_ON) {
-        zuc_initialize_req_flg = Y_ON;                                          /* Initialized request flag ON    */
-    }
+#if (LMCTL_1501_LABYRINTH_ENABLE == 1)
+/****************************************************************/
+/*  m_lmctl_1501_oled_generate_labirynth_step                   */
+/*--------------------------------------------------------------*/
+/*  Carve the labirynth on the OLED.                            */
+/*      (Luminous Control #1501)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <Budget [step]>                                 */
+/*  Returns: <uint8_t> Y_ON if the labirynth is completed       */
+/****************************************************************/
+static uint8_t m_lmctl_1501_oled_generate_labirynth_step(uint8_t uc_budget) {
+    uint8_t uc_end_flag = Y_OFF;                                    /* End flag                 */
 
-    // M_LMCTL_OLED_TRANSFER_BUFFER(zuc_lmctl_1501_labyrinth, zuc_LMCTL_oled_raw_buffer);    /* Transfer the buffer  */
+    while ((uc_budget != 0) && (uc_end_flag == Y_OFF)) {
+        uc_end_flag = m_lmctl_1501_oled_generate_labirynth_update();            /* Update the labirynth           */
+        uc_budget--;
+    }
 
-    return false;
+    return uc_end_flag;
 }
 
 /****************************************************************/
@@ -534,15 +1223,14 @@ static bool m_lmctl_1501_oled_generate_labirynth(const lmctl_context_t *pst_lmct
 /*  Labirynth initialization function.                          */
 /*                                                              */
 /*--------------------------------------------------------------*/
-/*  Period: 64ms                                                */
+/*  Period: OLED_UPDATE_INTERVAL                                */
 /*  Parameters: <>                                              */
 /*  Returns:                                                    */
 /****************************************************************/
 static void m_lmctl_1501_oled_generate_labirynth_init(void) {
     lmctl_point_t st_cursor;                                           /* Cursor position          */
 
-    // m_lmctl_oled_init_by_fill(zuc_lmctl_1501_labyrinth);    /* Initialize the labirynth   */
-    m_lmctl_oled_init_by_fill(zuc_LMCTL_oled_raw_buffer);    /* Initialize the labirynth   */
+    m_lmctl_oled_init_by_fill(0xFF);                        /* Initialize the labirynth   */
     
     /* Init the cursor position by random                   */
     /* Available range: 1 ~ (Y_LMCTL_OLED_ROW_NUM - 2)      */
@@ -559,17 +1247,9 @@ static void m_lmctl_1501_oled_generate_labirynth_init(void) {
     }
 
     /* Initialize point stack    */
-    zus_lmctl_1501_point_stack_idx = Y_LMCTL_OLED_STACK_EMPTY + 1;   /* Point stack index        */
-    zuc_lmctl_1501_point_stack_x[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_x;       /* X coordinate             */
-    zuc_lmctl_1501_point_stack_y[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_y;       /* Y coordinate             */
-
-    /* Set the cursor position to the labirynth            */
-    // M_LMCTL_OLED_CLEAR_BIT(
-    //     // zuc_lmctl_1501_labyrinth,
-    //     zuc_LMCTL_oled_raw_buffer,
-    //     st_cursor.uc_x,
-    //     st_cursor.uc_y
-    // );
+    M_LMCTL_1501_RAM.us_point_stack_idx = Y_LMCTL_OLED_STACK_EMPTY + 1;   /* Point stack index        */
+    M_LMCTL_1501_RAM.uc_point_stack_x[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_x;       /* X coordinate             */
+    M_LMCTL_1501_RAM.uc_point_stack_y[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_y;       /* Y coordinate             */
 }
 
 /****************************************************************/
@@ -586,39 +1266,39 @@ static uint8_t m_lmctl_1501_oled_generate_labirynth_update(void) {
     lmctl_point_t st_cursor;                                        /* Cursor position          */
     lmctl_point_t st_mid_point;                                     /* Mid point                */
 
-    while (zus_lmctl_1501_point_stack_idx > Y_LMCTL_OLED_STACK_EMPTY) {
+    while (M_LMCTL_1501_RAM.us_point_stack_idx > Y_LMCTL_OLED_STACK_EMPTY) {
         uint8_t uc_advanced_flg = Y_OFF;                                                        /* Advanced flag        */
         uint8_t uc_direction;                                                                   /* Direction            */
         uint8_t puc_direction_list[4] = {Y_LMCTL_OLED_NO_DIR};                                  /* Direction list           */
         uint8_t uc_direction_list_idx = 0;                                                      /* Direction list index     */
-        st_cursor.uc_x = zuc_lmctl_1501_point_stack_x[zus_lmctl_1501_point_stack_idx];          /* X coordinate */  // fixme
-        st_cursor.uc_y = zuc_lmctl_1501_point_stack_y[zus_lmctl_1501_point_stack_idx];          /* Y coordinate */
-        zus_lmctl_1501_point_stack_idx--;                                                       /* Decrement the index  */
+        st_cursor.uc_x = M_LMCTL_1501_RAM.uc_point_stack_x[M_LMCTL_1501_RAM.us_point_stack_idx];          /* X coordinate */  // fixme
+        st_cursor.uc_y = M_LMCTL_1501_RAM.uc_point_stack_y[M_LMCTL_1501_RAM.us_point_stack_idx];          /* Y coordinate */
+        M_LMCTL_1501_RAM.us_point_stack_idx--;                                                       /* Decrement the index  */
 
         /* if already visited */
-        if (M_LMCTL_OLED_GET_BIT(zuc_LMCTL_oled_raw_buffer, st_cursor.uc_x, st_cursor.uc_y) == Y_OFF) {
+        if (M_LMCTL_OLED_GET_BIT(st_cursor.uc_x, st_cursor.uc_y) == Y_OFF) {
             continue;                                                                           /* Skip the point        */
         }
 
         /* Check the directions     */
         /* if (have 2 pixels to advance AND not visited) */
         if ((st_cursor.uc_x > 2)
-         && (M_LMCTL_OLED_GET_BIT(zuc_LMCTL_oled_raw_buffer, st_cursor.uc_x - 2, st_cursor.uc_y) == Y_ON)) {
+         && (M_LMCTL_OLED_GET_BIT(st_cursor.uc_x - 2, st_cursor.uc_y) == Y_ON)) {
             puc_direction_list[uc_direction_list_idx] = Y_LMCTL_OLED_LEFT;      /* Left direction available */
             uc_direction_list_idx++;                                            /* Increment the index       */
         }
         if ((st_cursor.uc_x < (Y_LMCTL_OLED_ROW_NUM * 8 - 4)  // Thicker Wall (2pixels)
-         && (M_LMCTL_OLED_GET_BIT(zuc_LMCTL_oled_raw_buffer, st_cursor.uc_x + 2, st_cursor.uc_y) == Y_ON))) {
+         && (M_LMCTL_OLED_GET_BIT(st_cursor.uc_x + 2, st_cursor.uc_y) == Y_ON))) {
             puc_direction_list[uc_direction_list_idx] = Y_LMCTL_OLED_RIGHT;     /* Right direction available */
             uc_direction_list_idx++;                                            /* Increment the index       */
         }
         if ((st_cursor.uc_y > 2)
-         && (M_LMCTL_OLED_GET_BIT(zuc_LMCTL_oled_raw_buffer, st_cursor.uc_x, st_cursor.uc_y - 2) == Y_ON)) {
+         && (M_LMCTL_OLED_GET_BIT(st_cursor.uc_x, st_cursor.uc_y - 2) == Y_ON)) {
             puc_direction_list[uc_direction_list_idx] = Y_LMCTL_OLED_UP;        /* Up direction available    */
             uc_direction_list_idx++;                                            /* Increment the index       */
         }
         if ((st_cursor.uc_y < (Y_LMCTL_OLED_COL_NUM - 4))  // Thicker Wall (2pixels)
-         && (M_LMCTL_OLED_GET_BIT(zuc_LMCTL_oled_raw_buffer, st_cursor.uc_x, st_cursor.uc_y + 2) == Y_ON)) {
+         && (M_LMCTL_OLED_GET_BIT(st_cursor.uc_x, st_cursor.uc_y + 2) == Y_ON)) {
             puc_direction_list[uc_direction_list_idx] = Y_LMCTL_OLED_DOWN;      /* Down direction available  */
             uc_direction_list_idx++;                                            /* Increment the index       */
         }
@@ -640,33 +1320,33 @@ static uint8_t m_lmctl_1501_oled_generate_labirynth_update(void) {
                 uc_direction = puc_direction_list[uc_i];                        /* Direction                  */
                 switch (uc_direction) {
                     case Y_LMCTL_OLED_LEFT:
-                        zus_lmctl_1501_point_stack_idx++;             /* Increment the index        */
-                        zuc_lmctl_1501_point_stack_x[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_x - 2;    /* X coordinate */
-                        zuc_lmctl_1501_point_stack_y[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_y;        /* Y coordinate */
+                        M_LMCTL_1501_RAM.us_point_stack_idx++;             /* Increment the index        */
+                        M_LMCTL_1501_RAM.uc_point_stack_x[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_x - 2;    /* X coordinate */
+                        M_LMCTL_1501_RAM.uc_point_stack_y[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_y;        /* Y coordinate */
                         st_mid_point.uc_x = st_cursor.uc_x - 1;       /* Mid point X coordinate     */
                         st_mid_point.uc_y = st_cursor.uc_y;           /* Mid point Y coordinate     */
                         uc_advanced_flg = Y_ON;                                     /* Advanced flag              */
                         break;
                     case Y_LMCTL_OLED_RIGHT:
-                        zus_lmctl_1501_point_stack_idx++;             /* Increment the index        */
-                        zuc_lmctl_1501_point_stack_x[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_x + 2;    /* X coordinate */
-                        zuc_lmctl_1501_point_stack_y[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_y;        /* Y coordinate */
+                        M_LMCTL_1501_RAM.us_point_stack_idx++;             /* Increment the index        */
+                        M_LMCTL_1501_RAM.uc_point_stack_x[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_x + 2;    /* X coordinate */
+                        M_LMCTL_1501_RAM.uc_point_stack_y[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_y;        /* Y coordinate */
                         st_mid_point.uc_x = st_cursor.uc_x + 1;       /* Mid point X coordinate     */
                         st_mid_point.uc_y = st_cursor.uc_y;           /* Mid point Y coordinate     */
                         uc_advanced_flg = Y_ON;                                     /* Advanced flag              */
                         break;
                     case Y_LMCTL_OLED_UP:
-                        zus_lmctl_1501_point_stack_idx++;             /* Increment the index        */
-                        zuc_lmctl_1501_point_stack_x[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_x;        /* X coordinate */
-                        zuc_lmctl_1501_point_stack_y[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_y - 2;    /* Y coordinate */
+                        M_LMCTL_1501_RAM.us_point_stack_idx++;             /* Increment the index        */
+                        M_LMCTL_1501_RAM.uc_point_stack_x[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_x;        /* X coordinate */
+                        M_LMCTL_1501_RAM.uc_point_stack_y[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_y - 2;    /* Y coordinate */
                         st_mid_point.uc_x = st_cursor.uc_x;           /* Mid point X coordinate     */
                         st_mid_point.uc_y = st_cursor.uc_y - 1;       /* Mid point Y coordinate     */
                         uc_advanced_flg = Y_ON;                                     /* Advanced flag              */
                         break;
                     case Y_LMCTL_OLED_DOWN:
-                        zus_lmctl_1501_point_stack_idx++;             /* Increment the index        */
-                        zuc_lmctl_1501_point_stack_x[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_x;        /* X coordinate */
-                        zuc_lmctl_1501_point_stack_y[zus_lmctl_1501_point_stack_idx] = st_cursor.uc_y + 2;    /* Y coordinate */
+                        M_LMCTL_1501_RAM.us_point_stack_idx++;             /* Increment the index        */
+                        M_LMCTL_1501_RAM.uc_point_stack_x[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_x;        /* X coordinate */
+                        M_LMCTL_1501_RAM.uc_point_stack_y[M_LMCTL_1501_RAM.us_point_stack_idx] = st_cursor.uc_y + 2;    /* Y coordinate */
                         st_mid_point.uc_x = st_cursor.uc_x;           /* Mid point X coordinate     */
                         st_mid_point.uc_y = st_cursor.uc_y + 1;       /* Mid point Y coordinate     */
                         uc_advanced_flg = Y_ON;                                     /* Advanced flag              */
@@ -680,8 +1360,6 @@ static uint8_t m_lmctl_1501_oled_generate_labirynth_update(void) {
         /* If advanced, exit this function  */
         if (uc_advanced_flg == Y_ON) {
             M_LMCTL_OLED_CLEAR_BIT(
-                // zuc_lmctl_1501_labyrinth,
-                zuc_LMCTL_oled_raw_buffer,
                 st_mid_point.uc_x,
                 st_mid_point.uc_y
             );
@@ -691,13 +1369,11 @@ static uint8_t m_lmctl_1501_oled_generate_labirynth_update(void) {
 
     /* Update the labyrinth    */
     M_LMCTL_OLED_CLEAR_BIT(
-        // zuc_lmctl_1501_labyrinth,
-        zuc_LMCTL_oled_raw_buffer,
         st_cursor.uc_x,
         st_cursor.uc_y
     );
 
-    if (zus_lmctl_1501_point_stack_idx == Y_LMCTL_OLED_STACK_EMPTY) {
+    if (M_LMCTL_1501_RAM.us_point_stack_idx == Y_LMCTL_OLED_STACK_EMPTY) {
         return Y_ON;    /* Completed    */
     } else {
         return Y_OFF;   /* Not completed    */
@@ -705,6 +1381,149 @@ static uint8_t m_lmctl_1501_oled_generate_labirynth_update(void) {
 }
 #endif /* LMCTL_1501_LABYRINTH_ENABLE */
 
+#if (LMCTL_1502_LIFE_ENABLE == 1)
+/****************************************************************/
+/*  m_lmctl_1502_oled_life_init                                 */
+/*--------------------------------------------------------------*/
+/*  Seed the Game of Life with random cells.                    */
+/*      (Luminous Control #1502)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: effect (re)started                                  */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_1502_oled_life_init(void) {
+    for (uint16_t us_i = 0; us_i < (Y_LMCTL_OLED_COL_NUM * Y_LMCTL_OLED_ROW_NUM); us_i++) {
+        oled_write_raw_byte((uint8_t)rand(), us_i);                     /* About half of the cells alive    */
+    }
+    M_LMCTL_1502_RAM.us_generation = 0;
+
+#ifdef LMCTL_1502_MEASURE_CYCLES
+    M_TIMER1_INIT();                                                    /* Timer1 time base                 */
+#endif /* LMCTL_1502_MEASURE_CYCLES */
+}
+
+/****************************************************************/
+/*  m_lmctl_1502_oled_life_step                                 */
+/*--------------------------------------------------------------*/
+/*  Advance the Game of Life.                                   */
+/*      (Luminous Control #1502)                                */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <Budget [gen]>                                  */
+/*  Returns: <uint8_t> Y_ON to reseed (still life, or too old)  */
+/****************************************************************/
+static uint8_t m_lmctl_1502_oled_life_step(uint8_t uc_budget) {
+    uint8_t uc_changed_flg = Y_ON;                                  /* Any cell changed         */
+
+    while ((uc_budget != 0) && (uc_changed_flg == Y_ON)) {
+#ifdef LMCTL_1502_MEASURE_CYCLES
+        const uint16_t xus_start = M_TIMER1_TICKS();
+#endif /* LMCTL_1502_MEASURE_CYCLES */
+
+        uc_changed_flg = m_lmctl_1502_oled_life_generation();       /* One generation           */
+
+#ifdef LMCTL_1502_MEASURE_CYCLES
+        zul_lmctl_1502_cycles_last = (uint32_t)(uint16_t)(M_TIMER1_TICKS() - xus_start) * Y_TIMER1_PRESCALER;
+        if (zul_lmctl_1502_cycles_last > zul_lmctl_1502_cycles_max) {
+            zul_lmctl_1502_cycles_max = zul_lmctl_1502_cycles_last;
+        }
+#endif /* LMCTL_1502_MEASURE_CYCLES */
+
+        M_LMCTL_1502_RAM.us_generation++;
+        uc_budget--;
+    }
+
+    if ((uc_changed_flg == Y_OFF)
+     || (M_LMCTL_1502_RAM.us_generation >= Y_LMCTL_1502_GEN_MAX)) {
+        return Y_ON;                                                /* Reseed                   */
+    }
+    return Y_OFF;
+}
+
+/****************************************************************/
+/*  m_lmctl_1502_oled_life_generation                           */
+/*--------------------------------------------------------------*/
+/*  Compute one generation in place in the OLED driver buffer   */
+/*  (torus, 32 x 128 cells).                                    */
+/*                                                              */
+/*  A canvas row is a uint32_t (see M_LMCTL_OLED_GET_ROW), and  */
+/*  the 8 neighbour counts of the whole row are added bit-      */
+/*  sliced: every logical operation handles 32 cells, 8 per     */
+/*  byte operation on the AVR.                                  */
+/*      above / below : 3 cells -> 2-bit sums (su, cu)          */
+/*      middle        : 2 cells -> 2-bit sum  (sm, cm)          */
+/*      count = s0 + 2 * (cu + cm + cd + k0)                    */
+/*  A cell lives if count == 3, or count == 2 and it is alive,  */
+/*  i.e. if exactly one of (cu, cm, cd, k0) is set and          */
+/*  (s0 or alive).                                              */
+/*  The old values of the previous row and of the first row are */
+/*  the only scratch, as the rows are overwritten one by one.   */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters:                                                 */
+/*  Returns: <uint8_t> Y_ON if any cell changed                 */
+/****************************************************************/
+static uint8_t m_lmctl_1502_oled_life_generation(void) {
+    const uint8_t *xpuc_oled = M_LMCTL_OLED_BUFFER();                               /* Driver buffer            */
+    const uint32_t xul_first = M_LMCTL_OLED_GET_ROW(xpuc_oled, 0);                  /* Old first row            */
+    uint32_t ul_above = M_LMCTL_OLED_GET_ROW(xpuc_oled, Y_LMCTL_OLED_COL_NUM - 1);  /* Old previous row (wraps) */
+    uint32_t ul_middle = xul_first;                                                 /* Old current row          */
+    uint32_t ul_changed = 0;                                                        /* Changed cells            */
+
+    for (uint16_t us_col = 0; us_col < Y_LMCTL_OLED_COL_NUM; us_col++) {
+        const uint32_t xul_below = (us_col == (Y_LMCTL_OLED_COL_NUM - 1))
+                                 ? xul_first
+                                 : M_LMCTL_OLED_GET_ROW(xpuc_oled, us_col + 1);     /* Old next row             */
+        uint32_t ul_a, ul_b, ul_c;                                                  /* Adder inputs             */
+        uint32_t ul_su, ul_cu, ul_sm, ul_cm, ul_sd, ul_cd;                          /* Row sums                 */
+        uint32_t ul_s0, ul_k0, ul_one, ul_two;                                      /* Total                    */
+        uint32_t ul_next;                                                           /* New row                  */
+
+        /* Row above: 3 cells   */
+        ul_a = M_LMCTL_ROTL32(ul_above);
+        ul_b = M_LMCTL_ROTR32(ul_above);
+        ul_su = ul_a ^ ul_b ^ ul_above;
+        ul_cu = (ul_a & ul_b) | (ul_above & (ul_a ^ ul_b));
+
+        /* Row below: 3 cells   */
+        ul_a = M_LMCTL_ROTL32(xul_below);
+        ul_b = M_LMCTL_ROTR32(xul_below);
+        ul_sd = ul_a ^ ul_b ^ xul_below;
+        ul_cd = (ul_a & ul_b) | (xul_below & (ul_a ^ ul_b));
+
+        /* Middle row: 2 cells  */
+        ul_a = M_LMCTL_ROTL32(ul_middle);
+        ul_b = M_LMCTL_ROTR32(ul_middle);
+        ul_sm = ul_a ^ ul_b;
+        ul_cm = ul_a & ul_b;
+
+        /* Weight 1             */
+        ul_s0 = ul_su ^ ul_sm ^ ul_sd;
+        ul_k0 = (ul_su & ul_sm) | (ul_sd & (ul_su ^ ul_sm));
+
+        /* Weight 2: exactly one of cu, cm, cd, k0      */
+        ul_a = ul_cu ^ ul_cm;
+        ul_c = ul_cd ^ ul_k0;
+        ul_one = ul_a ^ ul_c;                                                       /* Odd number of them       */
+        ul_two = (ul_cu & ul_cm) | (ul_cd & ul_k0) | (ul_a & ul_c);                 /* At least two of them     */
+
+        ul_next = ul_one & ~ul_two & (ul_s0 | ul_middle);
+        ul_changed |= ul_next ^ ul_middle;
+
+        M_LMCTL_OLED_SET_ROW(us_col, ul_next);                                      /* Overwrite the row        */
+
+        ul_above = ul_middle;                                                       /* Roll the scratch         */
+        ul_middle = xul_below;
+    }
+
+    return (ul_changed != 0) ? Y_ON : Y_OFF;
+}
+#endif /* LMCTL_1502_LIFE_ENABLE */
+
 /****************************************************************/
 /*  m_lmctl_oled_init_by_frame                                  */
 /*--------------------------------------------------------------*/
@@ -772,20 +1591,103 @@ static void m_lmctl_oled_init_by_frame(
 /*                                                              */
 /*--------------------------------------------------------------*/
 /*  Period:                                                     */
-/*  Parameters: <Buffer>                                        */
+/*  Parameters: <Fill data>                                     */
 /*  Returns:                                                    */
 /****************************************************************/
 static void m_lmctl_oled_init_by_fill(
-    uint8_t puc_buffer[][Y_LMCTL_OLED_ROW_NUM]     /* Buffer to be initialized */
+    uint8_t uc_data                                /* Byte written everywhere  */
 ) {
-    for (uint16_t us_i = 0; us_i < Y_LMCTL_OLED_COL_NUM; us_i++) {
-        for (uint16_t us_j = 0; us_j < Y_LMCTL_OLED_ROW_NUM; us_j++) {
-            puc_buffer[us_i][us_j] = 0xFF;
-        }
+    for (uint16_t us_i = 0; us_i < (Y_LMCTL_OLED_COL_NUM * Y_LMCTL_OLED_ROW_NUM); us_i++) {
+        oled_write_raw_byte(uc_data, us_i);
     }
 }
 #endif /* LMCTL_1501_LABYRINTH_ENABLE */
 
+/****************************************************************/
+/*  m_lmctl_oled_redraw                                         */
+/*--------------------------------------------------------------*/
+/*  Clear the OLED and restart the idle effect, which draws in  */
+/*  the driver buffer and loses its state to the inspection     */
+/*  text or to the previous effect.                             */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: inspection mode toggled, effect changed             */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_oled_redraw(void) {
+    oled_clear();                                                       /* Clear the display        */
+    zuc_LMCTL_effect_init_req = Y_ON;                                   /* Restart the idle effect  */
+    zuc_LMCTL_oled_redraw_req = Y_OFF;
+}
+
+/****************************************************************/
+/*  m_lmctl_oled_draw_char                                      */
+/*--------------------------------------------------------------*/
+/*  Draw a glyph of the portrait font (6 x 8, opaque) at any    */
+/*  pixel position of the canvas. Each glyph row is a 6-bit     */
+/*  mask shifted into at most 2 bytes of one driver column.     */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <x [px]>, <y [px]>, <Character>                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmctl_oled_draw_char(uint8_t uc_x, uint8_t uc_y, char c_char) {
+    const uint8_t *xpuc_oled = M_LMCTL_OLED_BUFFER();                       /* Driver buffer            */
+    const uint8_t xuc_page = uc_x / 8;                                      /* First page               */
+    const uint8_t xuc_shift = uc_x % 8;                                     /* Bit in the page          */
+    const uint8_t *xpuc_glyph;                                              /* Rotated glyph (PROGMEM)  */
+
+    if (((uint8_t)c_char < Y_LMFONT_FIRST) || ((uint8_t)c_char > Y_LMFONT_LAST)) {
+        c_char = ' ';                                                       /* Not in the font          */
+    }
+    xpuc_glyph = Xuc_LMFONT_glyphs[(uint8_t)c_char - Y_LMFONT_FIRST];
+
+    for (uint8_t uc_r = 0; uc_r < Y_LMFONT_HEIGHT; uc_r++) {
+        const uint8_t xuc_y = uc_y + uc_r;                                  /* Canvas row               */
+        uint16_t us_idx;                                                    /* Driver byte index        */
+        uint16_t us_bits;                                                   /* Glyph row at uc_x        */
+        uint16_t us_mask;                                                   /* Glyph cell at uc_x       */
+
+        if (xuc_y >= Y_LMCTL_OLED_COL_NUM) {
+            break;                                                          /* Below the canvas         */
+        }
+        us_idx = M_LMCTL_OLED_INDEX(uc_x, xuc_y);
+        us_bits = (uint16_t)pgm_read_byte(&xpuc_glyph[uc_r]) << xuc_shift;
+        us_mask = (uint16_t)((1U << Y_LMFONT_WIDTH) - 1) << xuc_shift;
+
+        oled_write_raw_byte((xpuc_oled[us_idx] & ~(uint8_t)us_mask) | (uint8_t)us_bits, us_idx);
+        if (((us_mask >> 8) != 0) && ((xuc_page + 1) < Y_LMCTL_OLED_ROW_NUM)) {
+            us_idx += Y_LMCTL_OLED_COL_NUM;                                 /* Next page                */
+            oled_write_raw_byte((xpuc_oled[us_idx] & ~(uint8_t)(us_mask >> 8)) | (uint8_t)(us_bits >> 8), us_idx);
+        }
+    }
+}
+
+/****************************************************************/
+/*  m_lmctl_oled_draw_text_P                                    */
+/*--------------------------------------------------------------*/
+/*  Draw a PROGMEM string with the portrait font, clipped at    */
+/*  the right edge of the canvas.                               */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <x [px]>, <y [px]>, <Text (PROGMEM)>            */
+/*  Returns: <uint8_t> [px] x after the last glyph              */
+/****************************************************************/
+static uint8_t m_lmctl_oled_draw_text_P(uint8_t uc_x, uint8_t uc_y, const char *pc_text) {
+    char c_char = pgm_read_byte(pc_text);
+
+    while ((c_char != '\0') && ((uc_x + Y_LMFONT_WIDTH) <= (Y_LMCTL_OLED_ROW_NUM * 8))) {
+        m_lmctl_oled_draw_char(uc_x, uc_y, c_char);
+        uc_x += Y_LMFONT_WIDTH;
+        pc_text++;
+        c_char = pgm_read_byte(pc_text);
+    }
+    return uc_x;
+}
+
 /****************************************************************/
 /*  m_lmctl_record                                              */
 /*--------------------------------------------------------------*/
@@ -797,6 +1699,9 @@ static void m_lmctl_oled_init_by_fill(
 /*  Returns:                                                    */
 /****************************************************************/
 void m_lmctl_record(uint16_t keycode, keyrecord_t *record) {
+    zul_LMCTL_last_record_time = timer_read32();                            /* Leave idle / sleep       */
+    zus_LMCTL_frame_time = 0;                                               /* Full frame rate at once  */
+
     if (record->event.pressed) {
         zus_LMCTL_last_keycode = keycode;                                   /* Update the last keycode  */
 
@@ -807,7 +1712,50 @@ void m_lmctl_record(uint16_t keycode, keyrecord_t *record) {
             } else {
                 zuc_LMCTL_insp_mode_flg = Y_OFF;                            /* Inspection mode OFF      */
             }
+            zuc_LMCTL_oled_redraw_req = Y_ON;                               /* Clear the OLED           */
+            m_lmsto_settings()->uc_insp_mode_flg = zuc_LMCTL_insp_mode_flg; /* Persist the mode         */
+            m_lmsto_changed();
+        }
+
+        /* Next idle effect                 */
+        if (keycode == LM_NEXT) {
+            zuc_LMCTL_effect_idx++;
+            if (zuc_LMCTL_effect_idx >= Y_LMCTL_EFFECT_NUM) {
+                zuc_LMCTL_effect_idx = 0;                                   /* Wrap around              */
+            }
+            zuc_LMCTL_oled_redraw_req = Y_ON;                               /* Clear the OLED           */
+            zuc_LMCTL_ticker_req = Y_ON;                                    /* Show the new name        */
+            m_lmsto_settings()->uc_effect_id = zuc_LMCTL_effect_idx;        /* Persist the effect       */
+            m_lmsto_settings()->us_prng_seed = (uint16_t)rand();            /*  with a new seed         */
+            m_lmsto_changed();
+        }
+    }
+}
+
+/****************************************************************/
+/*  m_lmctl_follow                                              */
+/*--------------------------------------------------------------*/
+/*  Take the inspection mode and the idle effect of the master. */
+/*  The slave does not persist them, the master's settings      */
+/*  are sent again after every reset.                           */
+/*--------------------------------------------------------------*/
+/*  Period: state transaction received (slave, split_sync.c)    */
+/*  Parameters: <Inspection mode flag>, <Effect id>             */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmctl_follow(uint8_t uc_insp_mode_flg, uint8_t uc_effect_id) {
+    const uint8_t xuc_insp_mode_flg = (uc_insp_mode_flg == Y_ON) ? Y_ON : Y_OFF;
+
+    if (uc_effect_id >= Y_LMCTL_EFFECT_NUM) {
+        return;                                                             /* Unknown effect           */
+    }
+    if ((xuc_insp_mode_flg != zuc_LMCTL_insp_mode_flg) || (uc_effect_id != zuc_LMCTL_effect_idx)) {
+        if (uc_effect_id != zuc_LMCTL_effect_idx) {
+            zuc_LMCTL_ticker_req = Y_ON;                                    /* Show the new name        */
         }
+        zuc_LMCTL_insp_mode_flg = xuc_insp_mode_flg;
+        zuc_LMCTL_effect_idx = uc_effect_id;
+        zuc_LMCTL_oled_redraw_req = Y_ON;                                   /* Clear the OLED           */
     }
 }
 
@@ -29,6 +29,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /*  Includes                                                                                                                    */
 /********************************************************************************************************************************/
 #include "luminous_common.h"
+#include "luminous_config.h"
 #include QMK_KEYBOARD_H
 #include <stdio.h>
 
@@ -36,9 +37,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /*  Variables                                                                                                                   */
 /********************************************************************************************************************************/
 extern const char Xc_logo_indices[];
+#if (LMCTL_1201_BOOT_ANIM_ENABLE == 1)
+extern const uint8_t Xuc_boot_anim[];
+#endif /* LMCTL_1201_BOOT_ANIM_ENABLE */
 
 /********************************************************************************************************************************/
 /*  Functions                                                                                                                   */
 /********************************************************************************************************************************/
+void m_lmctl_init(void);
 void m_lmctl_main(void);
+void m_lmctl_housekeeping(void);
 void m_lmctl_record(uint16_t keycode, keyrecord_t *record);
+void m_lmctl_follow(uint8_t uc_insp_mode_flg, uint8_t uc_effect_id);
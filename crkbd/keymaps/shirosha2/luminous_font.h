@@ -0,0 +1,157 @@
+/********************************************************************************************************************************/
+/*  luminous_font.h                                                                                                             */
+/*                                                                                                                              */
+/*  This file is for the portrait font of the luminous control.                                                                 */
+/*      - glcdfont.c glyphs 0x20 ~ 0x7E, rotated at build time                                                                  */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  A glcdfont.c glyph is 6 column bytes, bit r of column k being the pixel (k, r) on the landscape character grid.            */
+/*  The luminous canvas is portrait and stores a canvas row as bits across the OLED pages, so a glyph is drawn fastest as 8     */
+/*  row masks, bit k of row r being the pixel (k, r). M_LMFONT_ROTATE transposes the 6 column bytes into those 8 row masks as   */
+/*  a constant expression, so the table below holds the glcdfont.c bytes verbatim and the compiler stores the rotated glyphs.   */
+/*  Keep the bytes in sync with keyboards/crkbd/lib/glcdfont.c (OLED_FONT_H) when the font changes.                            */
+/********************************************************************************************************************************/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_LMFONT_FIRST          (0x20)      /* First glyph (space)                                    */
+#define Y_LMFONT_LAST           (0x7E)      /* Last glyph (tilde)                                     */
+#define Y_LMFONT_WIDTH          (6)         /* [px] Glyph width (including the spacing column)        */
+#define Y_LMFONT_HEIGHT         (8)         /* [px] Glyph height                                      */
+
+/********************************************************************************************************************************/
+/*  Macros                                                                                                                      */
+/********************************************************************************************************************************/
+#define M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, r) \
+    (  (((c0) >> (r)) & 1)       | ((((c1) >> (r)) & 1) << 1) | ((((c2) >> (r)) & 1) << 2) \
+     | ((((c3) >> (r)) & 1) << 3) | ((((c4) >> (r)) & 1) << 4) | ((((c5) >> (r)) & 1) << 5))
+
+#define M_LMFONT_ROTATE(c0, c1, c2, c3, c4, c5) { \
+    M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 0), M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 1), \
+    M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 2), M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 3), \
+    M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 4), M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 5), \
+    M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 6), M_LMFONT_ROW(c0, c1, c2, c3, c4, c5, 7) }
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static const uint8_t PROGMEM Xuc_LMFONT_glyphs[Y_LMFONT_LAST - Y_LMFONT_FIRST + 1][Y_LMFONT_HEIGHT] = {
+    M_LMFONT_ROTATE(0x00, 0x00, 0x00, 0x00, 0x00, 0x00),   /* 0x20 ' ' */
+    M_LMFONT_ROTATE(0x00, 0x00, 0x5F, 0x00, 0x00, 0x00),   /* 0x21 '!' */
+    M_LMFONT_ROTATE(0x00, 0x07, 0x00, 0x07, 0x00, 0x00),   /* 0x22 '"' */
+    M_LMFONT_ROTATE(0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00),   /* 0x23 '#' */
+    M_LMFONT_ROTATE(0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00),   /* 0x24 '$' */
+    M_LMFONT_ROTATE(0x23, 0x13, 0x08, 0x64, 0x62, 0x00),   /* 0x25 '%' */
+    M_LMFONT_ROTATE(0x36, 0x49, 0x56, 0x20, 0x50, 0x00),   /* 0x26 '&' */
+    M_LMFONT_ROTATE(0x00, 0x08, 0x07, 0x03, 0x00, 0x00),   /* 0x27 ''' */
+    M_LMFONT_ROTATE(0x00, 0x1C, 0x22, 0x41, 0x00, 0x00),   /* 0x28 '(' */
+    M_LMFONT_ROTATE(0x00, 0x41, 0x22, 0x1C, 0x00, 0x00),   /* 0x29 ')' */
+    M_LMFONT_ROTATE(0x2A, 0x1C, 0x7F, 0x1C, 0x2A, 0x00),   /* 0x2A '*' */
+    M_LMFONT_ROTATE(0x08, 0x08, 0x3E, 0x08, 0x08, 0x00),   /* 0x2B '+' */
+    M_LMFONT_ROTATE(0x00, 0x80, 0x70, 0x30, 0x00, 0x00),   /* 0x2C ',' */
+    M_LMFONT_ROTATE(0x08, 0x08, 0x08, 0x08, 0x08, 0x00),   /* 0x2D '-' */
+    M_LMFONT_ROTATE(0x00, 0x00, 0x60, 0x60, 0x00, 0x00),   /* 0x2E '.' */
+    M_LMFONT_ROTATE(0x20, 0x10, 0x08, 0x04, 0x02, 0x00),   /* 0x2F '/' */
+    M_LMFONT_ROTATE(0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00),   /* 0x30 '0' */
+    M_LMFONT_ROTATE(0x00, 0x42, 0x7F, 0x40, 0x00, 0x00),   /* 0x31 '1' */
+    M_LMFONT_ROTATE(0x72, 0x49, 0x49, 0x49, 0x46, 0x00),   /* 0x32 '2' */
+    M_LMFONT_ROTATE(0x21, 0x41, 0x49, 0x4D, 0x33, 0x00),   /* 0x33 '3' */
+    M_LMFONT_ROTATE(0x18, 0x14, 0x12, 0x7F, 0x10, 0x00),   /* 0x34 '4' */
+    M_LMFONT_ROTATE(0x27, 0x45, 0x45, 0x45, 0x39, 0x00),   /* 0x35 '5' */
+    M_LMFONT_ROTATE(0x3C, 0x4A, 0x49, 0x49, 0x31, 0x00),   /* 0x36 '6' */
+    M_LMFONT_ROTATE(0x41, 0x21, 0x11, 0x09, 0x07, 0x00),   /* 0x37 '7' */
+    M_LMFONT_ROTATE(0x36, 0x49, 0x49, 0x49, 0x36, 0x00),   /* 0x38 '8' */
+    M_LMFONT_ROTATE(0x46, 0x49, 0x49, 0x29, 0x1E, 0x00),   /* 0x39 '9' */
+    M_LMFONT_ROTATE(0x00, 0x00, 0x14, 0x00, 0x00, 0x00),   /* 0x3A ':' */
+    M_LMFONT_ROTATE(0x00, 0x40, 0x34, 0x00, 0x00, 0x00),   /* 0x3B ';' */
+    M_LMFONT_ROTATE(0x00, 0x08, 0x14, 0x22, 0x41, 0x00),   /* 0x3C '<' */
+    M_LMFONT_ROTATE(0x14, 0x14, 0x14, 0x14, 0x14, 0x00),   /* 0x3D '=' */
+    M_LMFONT_ROTATE(0x00, 0x41, 0x22, 0x14, 0x08, 0x00),   /* 0x3E '>' */
+    M_LMFONT_ROTATE(0x02, 0x01, 0x59, 0x09, 0x06, 0x00),   /* 0x3F '?' */
+    M_LMFONT_ROTATE(0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x00),   /* 0x40 '@' */
+    M_LMFONT_ROTATE(0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00),   /* 0x41 'A' */
+    M_LMFONT_ROTATE(0x7F, 0x49, 0x49, 0x49, 0x36, 0x00),   /* 0x42 'B' */
+    M_LMFONT_ROTATE(0x3E, 0x41, 0x41, 0x41, 0x22, 0x00),   /* 0x43 'C' */
+    M_LMFONT_ROTATE(0x7F, 0x41, 0x41, 0x41, 0x3E, 0x00),   /* 0x44 'D' */
+    M_LMFONT_ROTATE(0x7F, 0x49, 0x49, 0x49, 0x41, 0x00),   /* 0x45 'E' */
+    M_LMFONT_ROTATE(0x7F, 0x09, 0x09, 0x09, 0x01, 0x00),   /* 0x46 'F' */
+    M_LMFONT_ROTATE(0x3E, 0x41, 0x41, 0x51, 0x73, 0x00),   /* 0x47 'G' */
+    M_LMFONT_ROTATE(0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00),   /* 0x48 'H' */
+    M_LMFONT_ROTATE(0x00, 0x41, 0x7F, 0x41, 0x00, 0x00),   /* 0x49 'I' */
+    M_LMFONT_ROTATE(0x20, 0x40, 0x41, 0x3F, 0x01, 0x00),   /* 0x4A 'J' */
+    M_LMFONT_ROTATE(0x7F, 0x08, 0x14, 0x22, 0x41, 0x00),   /* 0x4B 'K' */
+    M_LMFONT_ROTATE(0x7F, 0x40, 0x40, 0x40, 0x40, 0x00),   /* 0x4C 'L' */
+    M_LMFONT_ROTATE(0x7F, 0x02, 0x1C, 0x02, 0x7F, 0x00),   /* 0x4D 'M' */
+    M_LMFONT_ROTATE(0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00),   /* 0x4E 'N' */
+    M_LMFONT_ROTATE(0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00),   /* 0x4F 'O' */
+    M_LMFONT_ROTATE(0x7F, 0x09, 0x09, 0x09, 0x06, 0x00),   /* 0x50 'P' */
+    M_LMFONT_ROTATE(0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00),   /* 0x51 'Q' */
+    M_LMFONT_ROTATE(0x7F, 0x09, 0x19, 0x29, 0x46, 0x00),   /* 0x52 'R' */
+    M_LMFONT_ROTATE(0x26, 0x49, 0x49, 0x49, 0x32, 0x00),   /* 0x53 'S' */
+    M_LMFONT_ROTATE(0x03, 0x01, 0x7F, 0x01, 0x03, 0x00),   /* 0x54 'T' */
+    M_LMFONT_ROTATE(0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00),   /* 0x55 'U' */
+    M_LMFONT_ROTATE(0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00),   /* 0x56 'V' */
+    M_LMFONT_ROTATE(0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00),   /* 0x57 'W' */
+    M_LMFONT_ROTATE(0x63, 0x14, 0x08, 0x14, 0x63, 0x00),   /* 0x58 'X' */
+    M_LMFONT_ROTATE(0x03, 0x04, 0x78, 0x04, 0x03, 0x00),   /* 0x59 'Y' */
+    M_LMFONT_ROTATE(0x61, 0x59, 0x49, 0x4D, 0x43, 0x00),   /* 0x5A 'Z' */
+    M_LMFONT_ROTATE(0x00, 0x7F, 0x41, 0x41, 0x41, 0x00),   /* 0x5B '[' */
+    M_LMFONT_ROTATE(0x02, 0x04, 0x08, 0x10, 0x20, 0x00),   /* 0x5C backslash */
+    M_LMFONT_ROTATE(0x00, 0x41, 0x41, 0x41, 0x7F, 0x00),   /* 0x5D ']' */
+    M_LMFONT_ROTATE(0x04, 0x02, 0x01, 0x02, 0x04, 0x00),   /* 0x5E '^' */
+    M_LMFONT_ROTATE(0x40, 0x40, 0x40, 0x40, 0x40, 0x00),   /* 0x5F '_' */
+    M_LMFONT_ROTATE(0x00, 0x03, 0x07, 0x08, 0x00, 0x00),   /* 0x60 '`' */
+    M_LMFONT_ROTATE(0x20, 0x54, 0x54, 0x78, 0x40, 0x00),   /* 0x61 'a' */
+    M_LMFONT_ROTATE(0x7F, 0x28, 0x44, 0x44, 0x38, 0x00),   /* 0x62 'b' */
+    M_LMFONT_ROTATE(0x38, 0x44, 0x44, 0x44, 0x28, 0x00),   /* 0x63 'c' */
+    M_LMFONT_ROTATE(0x38, 0x44, 0x44, 0x28, 0x7F, 0x00),   /* 0x64 'd' */
+    M_LMFONT_ROTATE(0x38, 0x54, 0x54, 0x54, 0x18, 0x00),   /* 0x65 'e' */
+    M_LMFONT_ROTATE(0x00, 0x08, 0x7E, 0x09, 0x02, 0x00),   /* 0x66 'f' */
+    M_LMFONT_ROTATE(0x18, 0x24, 0x24, 0x1C, 0x78, 0x00),   /* 0x67 'g' */
+    M_LMFONT_ROTATE(0x7F, 0x08, 0x04, 0x04, 0x78, 0x00),   /* 0x68 'h' */
+    M_LMFONT_ROTATE(0x00, 0x44, 0x7D, 0x40, 0x00, 0x00),   /* 0x69 'i' */
+    M_LMFONT_ROTATE(0x20, 0x40, 0x40, 0x3D, 0x00, 0x00),   /* 0x6A 'j' */
+    M_LMFONT_ROTATE(0x7F, 0x10, 0x28, 0x44, 0x00, 0x00),   /* 0x6B 'k' */
+    M_LMFONT_ROTATE(0x00, 0x41, 0x7F, 0x40, 0x00, 0x00),   /* 0x6C 'l' */
+    M_LMFONT_ROTATE(0x7C, 0x04, 0x78, 0x04, 0x78, 0x00),   /* 0x6D 'm' */
+    M_LMFONT_ROTATE(0x7C, 0x08, 0x04, 0x04, 0x78, 0x00),   /* 0x6E 'n' */
+    M_LMFONT_ROTATE(0x38, 0x44, 0x44, 0x44, 0x38, 0x00),   /* 0x6F 'o' */
+    M_LMFONT_ROTATE(0x7C, 0x18, 0x24, 0x24, 0x18, 0x00),   /* 0x70 'p' */
+    M_LMFONT_ROTATE(0x18, 0x24, 0x24, 0x18, 0x7C, 0x00),   /* 0x71 'q' */
+    M_LMFONT_ROTATE(0x7C, 0x08, 0x04, 0x04, 0x08, 0x00),   /* 0x72 'r' */
+    M_LMFONT_ROTATE(0x48, 0x54, 0x54, 0x54, 0x24, 0x00),   /* 0x73 's' */
+    M_LMFONT_ROTATE(0x04, 0x04, 0x3F, 0x44, 0x24, 0x00),   /* 0x74 't' */
+    M_LMFONT_ROTATE(0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00),   /* 0x75 'u' */
+    M_LMFONT_ROTATE(0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00),   /* 0x76 'v' */
+    M_LMFONT_ROTATE(0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00),   /* 0x77 'w' */
+    M_LMFONT_ROTATE(0x44, 0x28, 0x10, 0x28, 0x44, 0x00),   /* 0x78 'x' */
+    M_LMFONT_ROTATE(0x4C, 0x90, 0x90, 0x90, 0x7C, 0x00),   /* 0x79 'y' */
+    M_LMFONT_ROTATE(0x44, 0x64, 0x54, 0x4C, 0x44, 0x00),   /* 0x7A 'z' */
+    M_LMFONT_ROTATE(0x00, 0x08, 0x36, 0x41, 0x00, 0x00),   /* 0x7B '{' */
+    M_LMFONT_ROTATE(0x00, 0x00, 0x77, 0x00, 0x00, 0x00),   /* 0x7C '|' */
+    M_LMFONT_ROTATE(0x00, 0x41, 0x36, 0x08, 0x00, 0x00),   /* 0x7D '}' */
+    M_LMFONT_ROTATE(0x02, 0x01, 0x02, 0x04, 0x02, 0x00),   /* 0x7E '~' */
+};
@@ -0,0 +1,342 @@
+/********************************************************************************************************************************/
+/*  luminous_hwfx.c                                                                                                             */
+/*                                                                                                                              */
+/*  This file is for the OLED effects done by the SSD1306 itself.                                                               */
+/*      - Contrast fades                                                                                                        */
+/*      - Display start line shift (burn-in protection)                                                                         */
+/*      - Hardware scroll tickers                                                                                               */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  A redraw of the whole panel is 512 bytes on the I2C bus. The transitions here are done with controller commands instead,    */
+/*  a few bytes per frame at most:                                                                                              */
+/*      Fade   : contrast (0x81) moved linearly to a target over a given time, sent only when the value changes. This dims      */
+/*               the panel and no more: the SSD1306 still lights the pixels at contrast 0, so a fade out ends in oled_clear()   */
+/*               or oled_off().                                                                                                 */
+/*      Shift  : display start line (0x40 | line) stepped 0, 1 .. Y_LMHW_SHIFT_MAX .. 1, 0 every Y_LMHW_SHIFT_PERIOD, moving    */
+/*               the picture across the 32 px side so no pixel stays lit in the same place. The panel shows 32 of the 64        */
+/*               GDDRAM rows; the 32 hidden rows that come into view are cleared once at init.                                  */
+/*      Ticker : horizontal scroll of the whole panel for a given time. The QMK driver does not render while it scrolls, and    */
+/*               redraws the buffer once the scroll is turned off.                                                              */
+/********************************************************************************************************************************/
+
+/********************************************************************************************************************************/
+/* Includes                                                                                                                     */
+/********************************************************************************************************************************/
+#include "luminous_hwfx.h"
+#include "luminous_common.h"
+#include QMK_KEYBOARD_H
+#if (OLED_DRIVER_ENABLE == 1)
+#include "i2c_master.h"
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_LMHW_I2C_TIMEOUT      (100)       /* [ms,1] I2C transfer timeout                                    */
+#define Y_LMHW_CTRL_CMD         (0x00)      /* Control byte: command stream                                   */
+#define Y_LMHW_CTRL_DATA        (0x40)      /* Control byte: data stream                                      */
+#define Y_LMHW_CMD_START_LINE   (0x40)      /* Set display start line (| line)                                */
+#define Y_LMHW_CMD_COL_ADDR     (0x21)      /* Set column address (start, end)                                */
+#define Y_LMHW_CMD_PAGE_ADDR    (0x22)      /* Set page address (start, end)                                  */
+#define Y_LMHW_COL_NUM          (128)       /* Columns of the GDDRAM                                          */
+#define Y_LMHW_PAGE_SHOWN       (4)         /* Pages on the 128 x 32 panel                                    */
+#define Y_LMHW_PAGE_NUM         (8)         /* Pages of the GDDRAM (64 rows)                                  */
+#define Y_LMHW_CLEAR_CHUNK      (16)        /* [byte] Zero bytes per I2C transfer of the hidden page clear    */
+#define Y_LMHW_SHIFT_MAX        (3)         /* [px] Largest start line shift                                  */
+#define Y_LMHW_SHIFT_PERIOD     (60000)     /* [ms,1] Time on each shift position                             */
+#define Y_LMHW_SCROLL_SPEED     (4)         /* QMK scroll speed (0: slowest ~ 7: fastest)                     */
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static uint32_t zul_LMHW_time = 0;                                  /* [ms,1] Last task                              */
+static uint8_t zuc_LMHW_contrast = OLED_BRIGHTNESS;                 /* [-,-] Contrast sent to the panel              */
+static uint8_t zuc_LMHW_fade_from = OLED_BRIGHTNESS;                /* [-,-] Contrast at the start of the fade       */
+static uint8_t zuc_LMHW_fade_to = OLED_BRIGHTNESS;                  /* [-,-] Contrast at the end of the fade         */
+static uint16_t zus_LMHW_fade_time = 0;                             /* [ms,1] Length of the fade                     */
+static uint16_t zus_LMHW_fade_elapsed = 0;                          /* [ms,1] Time into the fade                     */
+static uint8_t zuc_LMHW_shift_flg = Y_OFF;                          /* [-,-] Start line shift enabled                */
+static uint8_t zuc_LMHW_shift_step = 0;                             /* [-,-] Position in 0 .. 2 * Y_LMHW_SHIFT_MAX   */
+static uint32_t zul_LMHW_shift_elapsed = 0;                         /* [ms,1] Time on the current position           */
+static uint8_t zuc_LMHW_start_line = 0;                             /* [px] Start line sent to the panel             */
+static uint16_t zus_LMHW_scroll_left = 0;                           /* [ms,1] Ticker time left, 0: no ticker         */
+static uint8_t zuc_LMHW_scroll_on_flg = Y_OFF;                      /* [-,-] Scroll accepted by the driver           */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+static void m_lmhw_send_cmd(uint8_t uc_cmd);
+static void m_lmhw_clear_hidden(void);
+static void m_lmhw_fade_task(uint16_t us_delta_time);
+static void m_lmhw_shift_task(uint16_t us_delta_time);
+static void m_lmhw_ticker_task(uint16_t us_delta_time);
+
+/****************************************************************/
+/*  m_lmhw_init                                                 */
+/*--------------------------------------------------------------*/
+/*  Clear the GDDRAM rows the start line shift brings into      */
+/*  view.                                                       */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init (after oled_init)                */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmhw_init(void) {
+    m_lmhw_clear_hidden();
+    zuc_LMHW_contrast = oled_get_brightness();
+    zuc_LMHW_fade_from = zuc_LMHW_contrast;
+    zuc_LMHW_fade_to = zuc_LMHW_contrast;
+    zul_LMHW_time = timer_read32();
+}
+
+/****************************************************************/
+/*  m_lmhw_task                                                 */
+/*--------------------------------------------------------------*/
+/*  Advance the transitions and send the commands that changed. */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmhw_task(void) {
+    const uint32_t xul_now = timer_read32();                            /* [ms] Now                         */
+    uint32_t ul_delta_time = TIMER_DIFF_32(xul_now, zul_LMHW_time);     /* [ms] Since the last task         */
+
+    if (ul_delta_time > UINT16_MAX) {
+        ul_delta_time = UINT16_MAX;
+    }
+    zul_LMHW_time = xul_now;
+
+    m_lmhw_fade_task((uint16_t)ul_delta_time);
+    m_lmhw_shift_task((uint16_t)ul_delta_time);
+    m_lmhw_ticker_task((uint16_t)ul_delta_time);
+}
+
+/****************************************************************/
+/*  m_lmhw_fade                                                 */
+/*--------------------------------------------------------------*/
+/*  Move the contrast to a target. A fade to the target already */
+/*  under way goes on, so it may be requested in every frame.   */
+/*  Contrast 0 is dim, not black: clear or turn off the panel   */
+/*  at the end of a fade out.                                   */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Target contrast>, <Time [ms]> (0: at once)     */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmhw_fade(uint8_t uc_target, uint16_t us_time) {
+    if ((uc_target == zuc_LMHW_fade_to) && (us_time != 0)) {
+        return;                                                         /* Already going there              */
+    }
+    zuc_LMHW_fade_from = zuc_LMHW_contrast;
+    zuc_LMHW_fade_to = uc_target;
+    zus_LMHW_fade_time = us_time;
+    zus_LMHW_fade_elapsed = 0;
+    if (us_time == 0) {
+        m_lmhw_fade_task(0);                                            /* Immediate                        */
+    }
+}
+
+/****************************************************************/
+/*  m_lmhw_shift                                                */
+/*--------------------------------------------------------------*/
+/*  Start or stop the start line shift. Stopping puts the       */
+/*  picture back in place.                                      */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Y_ON: shift, Y_OFF: stop>                      */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmhw_shift(uint8_t uc_enable_flg) {
+    if (uc_enable_flg == zuc_LMHW_shift_flg) {
+        return;
+    }
+    zuc_LMHW_shift_flg = uc_enable_flg;
+    zuc_LMHW_shift_step = 0;
+    zul_LMHW_shift_elapsed = 0;
+    if ((uc_enable_flg == Y_OFF) && (zuc_LMHW_start_line != 0)) {
+        zuc_LMHW_start_line = 0;
+        m_lmhw_send_cmd(Y_LMHW_CMD_START_LINE);
+    }
+}
+
+/****************************************************************/
+/*  m_lmhw_ticker                                               */
+/*--------------------------------------------------------------*/
+/*  Scroll the panel for a while. The scroll starts once the    */
+/*  driver has sent the buffer drawn for it.                    */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Time [ms]>                                     */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmhw_ticker(uint16_t us_time) {
+    zus_LMHW_scroll_left = us_time;
+}
+
+/****************************************************************/
+/*  m_lmhw_scrolling                                            */
+/*--------------------------------------------------------------*/
+/*  A ticker is pending or running (the buffer is not shown).   */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters:                                                 */
+/*  Returns: <uint8_t> Y_ON: ticker                             */
+/****************************************************************/
+uint8_t m_lmhw_scrolling(void) {
+    return ((zus_LMHW_scroll_left != 0) || (zuc_LMHW_scroll_on_flg == Y_ON)) ? Y_ON : Y_OFF;
+}
+
+/****************************************************************/
+/*  m_lmhw_send_cmd                                             */
+/*--------------------------------------------------------------*/
+/*  Send one command byte, with the start line or'ed in for     */
+/*  Y_LMHW_CMD_START_LINE.                                      */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Command>                                       */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmhw_send_cmd(uint8_t uc_cmd) {
+    uint8_t uc_buf[2];                                                  /* Control byte, command            */
+
+    uc_buf[0] = Y_LMHW_CTRL_CMD;
+    uc_buf[1] = (uc_cmd == Y_LMHW_CMD_START_LINE) ? (uint8_t)(uc_cmd | zuc_LMHW_start_line) : uc_cmd;
+    (void)i2c_transmit(OLED_DISPLAY_ADDRESS << 1, uc_buf, sizeof(uc_buf), Y_LMHW_I2C_TIMEOUT);
+}
+
+/****************************************************************/
+/*  m_lmhw_clear_hidden                                         */
+/*--------------------------------------------------------------*/
+/*  Zero the GDDRAM pages below the panel. The driver sets its  */
+/*  own address window before every render.                     */
+/*--------------------------------------------------------------*/
+/*  Period: init                                                */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmhw_clear_hidden(void) {
+    static const uint8_t PROGMEM Xuc_window[] = {
+        Y_LMHW_CTRL_CMD,
+        Y_LMHW_CMD_COL_ADDR, 0, Y_LMHW_COL_NUM - 1,
+        Y_LMHW_CMD_PAGE_ADDR, Y_LMHW_PAGE_SHOWN, Y_LMHW_PAGE_NUM - 1
+    };
+    uint8_t uc_buf[1 + Y_LMHW_CLEAR_CHUNK] = {0};                       /* Control byte, zeros              */
+
+    memcpy_P(uc_buf, Xuc_window, sizeof(Xuc_window));
+    if (i2c_transmit(OLED_DISPLAY_ADDRESS << 1, uc_buf, sizeof(Xuc_window), Y_LMHW_I2C_TIMEOUT) != I2C_STATUS_SUCCESS) {
+        return;                                                         /* No panel                         */
+    }
+    memset(uc_buf, 0, sizeof(uc_buf));
+    uc_buf[0] = Y_LMHW_CTRL_DATA;
+    for (uint16_t us_i = 0; us_i < (Y_LMHW_PAGE_NUM - Y_LMHW_PAGE_SHOWN) * Y_LMHW_COL_NUM; us_i += Y_LMHW_CLEAR_CHUNK) {
+        (void)i2c_transmit(OLED_DISPLAY_ADDRESS << 1, uc_buf, sizeof(uc_buf), Y_LMHW_I2C_TIMEOUT);
+    }
+}
+
+/****************************************************************/
+/*  m_lmhw_fade_task                                            */
+/*--------------------------------------------------------------*/
+/*  Interpolate the contrast, send it when it changes.          */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <Delta time [ms]>                               */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmhw_fade_task(uint16_t us_delta_time) {
+    uint8_t uc_contrast;                                                /* Contrast of this frame           */
+
+    if (zus_LMHW_fade_elapsed >= zus_LMHW_fade_time) {
+        uc_contrast = zuc_LMHW_fade_to;                                 /* Done (or immediate)              */
+    } else {
+        zus_LMHW_fade_elapsed = ((uint32_t)zus_LMHW_fade_elapsed + us_delta_time >= zus_LMHW_fade_time)
+                              ? zus_LMHW_fade_time : (uint16_t)(zus_LMHW_fade_elapsed + us_delta_time);
+        uc_contrast = (uint8_t)((int16_t)zuc_LMHW_fade_from
+                    + (int16_t)(((int32_t)((int16_t)zuc_LMHW_fade_to - zuc_LMHW_fade_from) * zus_LMHW_fade_elapsed)
+                                / zus_LMHW_fade_time));
+    }
+    if (uc_contrast != zuc_LMHW_contrast) {
+        zuc_LMHW_contrast = oled_set_brightness(uc_contrast);
+    }
+}
+
+/****************************************************************/
+/*  m_lmhw_shift_task                                           */
+/*--------------------------------------------------------------*/
+/*  Step the start line back and forth.                         */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <Delta time [ms]>                               */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmhw_shift_task(uint16_t us_delta_time) {
+    uint8_t uc_line;                                                    /* [px] Start line of this step     */
+
+    if ((zuc_LMHW_shift_flg == Y_OFF) || !is_oled_on()) {
+        return;
+    }
+    zul_LMHW_shift_elapsed += us_delta_time;
+    if (zul_LMHW_shift_elapsed < Y_LMHW_SHIFT_PERIOD) {
+        return;
+    }
+    zul_LMHW_shift_elapsed = 0;
+    zuc_LMHW_shift_step = (zuc_LMHW_shift_step + 1) % (2 * Y_LMHW_SHIFT_MAX);
+    uc_line = (zuc_LMHW_shift_step <= Y_LMHW_SHIFT_MAX) ? zuc_LMHW_shift_step : (uint8_t)(2 * Y_LMHW_SHIFT_MAX - zuc_LMHW_shift_step);
+    if (uc_line != zuc_LMHW_start_line) {
+        zuc_LMHW_start_line = uc_line;
+        m_lmhw_send_cmd(Y_LMHW_CMD_START_LINE);
+    }
+}
+
+/****************************************************************/
+/*  m_lmhw_ticker_task                                          */
+/*--------------------------------------------------------------*/
+/*  Start the requested scroll as soon as the driver takes it,  */
+/*  and stop it when the time is up.                            */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters: <Delta time [ms]>                               */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmhw_ticker_task(uint16_t us_delta_time) {
+    if (zus_LMHW_scroll_left == 0) {
+        if (zuc_LMHW_scroll_on_flg == Y_ON) {
+            oled_scroll_off();                                          /* The driver redraws the buffer    */
+            zuc_LMHW_scroll_on_flg = Y_OFF;
+        }
+        return;
+    }
+    if (zuc_LMHW_scroll_on_flg == Y_OFF) {
+        oled_scroll_set_speed(Y_LMHW_SCROLL_SPEED);
+        if (oled_scroll_left()) {                                       /* Refused while the buffer is dirty */
+            zuc_LMHW_scroll_on_flg = Y_ON;
+        }
+        return;                                                         /* Time runs once it moves          */
+    }
+    zus_LMHW_scroll_left = (us_delta_time >= zus_LMHW_scroll_left) ? 0 : (uint16_t)(zus_LMHW_scroll_left - us_delta_time);
+}
+
+#endif /* OLED_DRIVER_ENABLE */
@@ -0,0 +1,43 @@
+/********************************************************************************************************************************/
+/*  luminous_hwfx.h                                                                                                             */
+/*                                                                                                                              */
+/*  This file is for the OLED effects done by the SSD1306 itself.                                                               */
+/*      - Contrast fades                                                                                                        */
+/*      - Display start line shift (burn-in protection)                                                                         */
+/*      - Hardware scroll tickers                                                                                               */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Includes                                                                                                                    */
+/********************************************************************************************************************************/
+#include "luminous_common.h"
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+void m_lmhw_init(void);
+void m_lmhw_task(void);
+void m_lmhw_fade(uint8_t uc_target, uint16_t us_time);
+void m_lmhw_shift(uint8_t uc_enable_flg);
+void m_lmhw_ticker(uint16_t us_time);
+uint8_t m_lmhw_scrolling(void);
@@ -0,0 +1,219 @@
+/********************************************************************************************************************************/
+/*  luminous_store.c                                                                                                            */
+/*                                                                                                                              */
+/*  This file is for the settings store of the luminous control.                                                                */
+/*      - Wear-leveled log in the EEPROM user datablock                                                                         */
+/*      - Lazy write-back                                                                                                       */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  The EEPROM user datablock holds Y_LMSTO_SLOT_NUM slots of Y_LMSTO_SLOT_SIZE bytes:                                          */
+/*      [0]     : sequence number (wraps, compared as a signed 8-bit difference)                                                */
+/*      [1..6]  : lmsto_settings_t                                                                                              */
+/*      [7]     : checksum (~sum of bytes 0..6), so that an erased (0x00 / 0xFF) slot is never valid                            */
+/*  The slot with the newest valid sequence is read once at boot. Each save goes to the next slot, so every cell is written     */
+/*  once per Y_LMSTO_SLOT_NUM saves.                                                                                            */
+/*                                                                                                                              */
+/*  A save starts Y_LMSTO_SAVE_DELAY after the last change, and only if the settings differ from the stored ones. It writes     */
+/*  one byte per housekeeping pass (an EEPROM byte write takes ~3.4ms on the 32u4), checksum last, so a save never stalls the   */
+/*  scan loop for more than one byte and a save torn by a power loss leaves the previous slot in charge.                        */
+/********************************************************************************************************************************/
+
+/********************************************************************************************************************************/
+/* Includes                                                                                                                     */
+/********************************************************************************************************************************/
+#include "luminous_store.h"
+#include "luminous_common.h"
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_LMSTO_SAVE_DELAY      (5000)      /* [ms] Quiet time before changed settings are written                */
+#define Y_LMSTO_IDX_SEQUENCE    (0)         /* Slot offset of the sequence number                                 */
+#define Y_LMSTO_IDX_SETTINGS    (1)         /* Slot offset of the settings                                        */
+#define Y_LMSTO_IDX_CHECKSUM    (Y_LMSTO_SLOT_SIZE - 1)    /* Slot offset of the checksum                         */
+#define Y_LMSTO_NO_SLOT         (0xFF)      /* No valid slot                                                      */
+#define Y_LMSTO_WRITE_IDLE      (0xFF)      /* No save in progress                                                */
+
+_Static_assert(Y_LMSTO_SLOT_NUM * Y_LMSTO_SLOT_SIZE <= EECONFIG_USER_DATA_SIZE,
+               "luminous_store: the log must fit in EECONFIG_USER_DATA_SIZE (config.h)");
+
+/********************************************************************************************************************************/
+/*  Macros                                                                                                                      */
+/********************************************************************************************************************************/
+#define M_LMSTO_SLOT_ADDR(uc_slot)      (EECONFIG_USER_DATABLOCK + (uc_slot) * Y_LMSTO_SLOT_SIZE)
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static lmsto_settings_t zst_LMSTO_settings = {0};                   /* [-,-] Current settings                        */
+static lmsto_settings_t zst_LMSTO_saved_settings = {0};             /* [-,-] Settings in the newest slot             */
+static uint8_t zuc_LMSTO_slot = Y_LMSTO_NO_SLOT;                    /* [-,-] Newest valid slot                       */
+static uint8_t zuc_LMSTO_sequence = 0;                              /* [-,-] Sequence number of the newest slot      */
+static uint32_t zul_LMSTO_change_time = 0;                          /* [ms,1] Last change of the settings            */
+static uint8_t zuc_LMSTO_write_buffer[Y_LMSTO_SLOT_SIZE] = {0};     /* [-,-] Slot image being written                */
+static uint8_t zuc_LMSTO_write_idx = Y_LMSTO_WRITE_IDLE;            /* [-,-] Next byte to write                      */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+static uint8_t m_lmsto_checksum(const uint8_t puc_slot[]);
+static void m_lmsto_write_start(void);
+
+/****************************************************************/
+/*  m_lmsto_init                                                */
+/*--------------------------------------------------------------*/
+/*  Load the newest valid slot from the EEPROM.                 */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init                                  */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmsto_init(void) {
+    uint8_t puc_slot[Y_LMSTO_SLOT_SIZE];                                /* Slot image                       */
+
+    if (!eeconfig_is_user_datablock_valid()) {
+        eeconfig_init_user_datablock();                                 /* Layout changed: start over       */
+    }
+
+    for (uint8_t uc_slot = 0; uc_slot < Y_LMSTO_SLOT_NUM; uc_slot++) {
+        eeprom_read_block(puc_slot, (const void *)M_LMSTO_SLOT_ADDR(uc_slot), Y_LMSTO_SLOT_SIZE);
+
+        if (puc_slot[Y_LMSTO_IDX_CHECKSUM] != m_lmsto_checksum(puc_slot)) {
+            continue;                                                   /* Erased or torn slot              */
+        }
+        if ((zuc_LMSTO_slot == Y_LMSTO_NO_SLOT)
+         || ((int8_t)(puc_slot[Y_LMSTO_IDX_SEQUENCE] - zuc_LMSTO_sequence) > 0)) {
+            zuc_LMSTO_slot = uc_slot;                                   /* Newer slot                       */
+            zuc_LMSTO_sequence = puc_slot[Y_LMSTO_IDX_SEQUENCE];
+            memcpy(&zst_LMSTO_saved_settings, &puc_slot[Y_LMSTO_IDX_SETTINGS], sizeof(lmsto_settings_t));
+        }
+    }
+
+    zst_LMSTO_settings = zst_LMSTO_saved_settings;                      /* Defaults (0) if nothing is valid */
+}
+
+/****************************************************************/
+/*  m_lmsto_task                                                */
+/*--------------------------------------------------------------*/
+/*  Write the settings back once they settled, one byte per     */
+/*  call.                                                       */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping                                        */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmsto_task(void) {
+    if (zuc_LMSTO_write_idx == Y_LMSTO_WRITE_IDLE) {
+        if ((timer_elapsed32(zul_LMSTO_change_time) > Y_LMSTO_SAVE_DELAY)
+         && (memcmp(&zst_LMSTO_settings, &zst_LMSTO_saved_settings, sizeof(lmsto_settings_t)) != 0)) {
+            m_lmsto_write_start();                                      /* Snapshot into the next slot      */
+        }
+        return;
+    }
+
+    eeprom_update_byte(
+        M_LMSTO_SLOT_ADDR(zuc_LMSTO_slot) + zuc_LMSTO_write_idx,
+        zuc_LMSTO_write_buffer[zuc_LMSTO_write_idx]
+    );
+    zuc_LMSTO_write_idx++;
+
+    if (zuc_LMSTO_write_idx >= Y_LMSTO_SLOT_SIZE) {
+        zuc_LMSTO_write_idx = Y_LMSTO_WRITE_IDLE;                       /* Checksum written: slot committed */
+    }
+}
+
+/****************************************************************/
+/*  m_lmsto_settings                                            */
+/*--------------------------------------------------------------*/
+/*  Access to the current settings. Call m_lmsto_changed()      */
+/*  after modifying them.                                       */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters:                                                 */
+/*  Returns: <lmsto_settings_t *> Current settings              */
+/****************************************************************/
+lmsto_settings_t *m_lmsto_settings(void) {
+    return &zst_LMSTO_settings;
+}
+
+/****************************************************************/
+/*  m_lmsto_changed                                             */
+/*--------------------------------------------------------------*/
+/*  Restart the save delay.                                     */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: settings modified                                   */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_lmsto_changed(void) {
+    zul_LMSTO_change_time = timer_read32();
+}
+
+/****************************************************************/
+/*  m_lmsto_checksum                                            */
+/*--------------------------------------------------------------*/
+/*  Checksum of a slot image.                                   */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Slot image>                                    */
+/*  Returns: <uint8_t> ~(sum of the bytes before the checksum)  */
+/****************************************************************/
+static uint8_t m_lmsto_checksum(const uint8_t puc_slot[]) {
+    uint8_t uc_sum = 0;
+
+    for (uint8_t uc_i = 0; uc_i < Y_LMSTO_IDX_CHECKSUM; uc_i++) {
+        uc_sum += puc_slot[uc_i];
+    }
+    return (uint8_t)~uc_sum;
+}
+
+/****************************************************************/
+/*  m_lmsto_write_start                                         */
+/*--------------------------------------------------------------*/
+/*  Build the image of the next slot and start writing it.      */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping                                        */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_lmsto_write_start(void) {
+    if (zuc_LMSTO_slot == Y_LMSTO_NO_SLOT) {
+        zuc_LMSTO_slot = 0;                                             /* First save                       */
+    } else {
+        zuc_LMSTO_slot = (zuc_LMSTO_slot + 1) % Y_LMSTO_SLOT_NUM;       /* Next slot                        */
+    }
+    zuc_LMSTO_sequence++;
+    zst_LMSTO_saved_settings = zst_LMSTO_settings;
+
+    zuc_LMSTO_write_buffer[Y_LMSTO_IDX_SEQUENCE] = zuc_LMSTO_sequence;
+    memcpy(&zuc_LMSTO_write_buffer[Y_LMSTO_IDX_SETTINGS], &zst_LMSTO_saved_settings, sizeof(lmsto_settings_t));
+    zuc_LMSTO_write_buffer[Y_LMSTO_IDX_CHECKSUM] = m_lmsto_checksum(zuc_LMSTO_write_buffer);
+    zuc_LMSTO_write_idx = 0;
+}
@@ -0,0 +1,57 @@
+/********************************************************************************************************************************/
+/*  luminous_store.h                                                                                                            */
+/*                                                                                                                              */
+/*  This file is for the settings store of the luminous control.                                                                */
+/*      - Wear-leveled log in the EEPROM user datablock                                                                         */
+/*      - Lazy write-back                                                                                                       */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Includes                                                                                                                    */
+/********************************************************************************************************************************/
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_LMSTO_SLOT_NUM        (4)         /* Number of log slots                                                */
+#define Y_LMSTO_SLOT_SIZE       (8)         /* [byte] Sequence + settings + checksum                              */
+
+/********************************************************************************************************************************/
+/*  Structures                                                                                                                  */
+/********************************************************************************************************************************/
+typedef struct {
+    uint8_t uc_insp_mode_flg;           /* Inspection mode flag                         */
+    uint8_t uc_effect_id;               /* Selected idle effect                         */
+    uint16_t us_prng_seed;              /* Mixed into the boot seed of rand()           */
+    uint8_t uc_reserved[2];             /* RGB parameters (reserved, 0)                 */
+} lmsto_settings_t;                     /* Luminous settings                            */
+
+_Static_assert(sizeof(lmsto_settings_t) == Y_LMSTO_SLOT_SIZE - 2, "luminous_store: settings must fill a log slot");
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+void m_lmsto_init(void);
+void m_lmsto_task(void);
+lmsto_settings_t *m_lmsto_settings(void);
+void m_lmsto_changed(void);
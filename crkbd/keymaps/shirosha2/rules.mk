@@ -1,4 +1,26 @@
 SRC += luminous_control.c
+SRC += luminous_hwfx.c
+SRC += luminous_anim.c
+SRC += luminous_store.c
+SRC += adaptive_tapping.c
+SRC += latency_probe.c
+SRC += split_sync.c
+
+# Raw HID telemetry, read with tools/tlm_monitor.cpp
+RAW_ENABLE = yes
+ifeq ($(strip $(RAW_ENABLE)), yes)
+    SRC += telemetry.c
+endif
+
+# Key event trace, dumped through the raw HID telemetry
+# (QMK's default debounce, rebuilt to count the raw bounces: lib/keytrace_debounce.c)
+KEYTRACE_ENABLE = yes
+ifeq ($(strip $(KEYTRACE_ENABLE)), yes)
+    SRC += ./lib/keytrace.c
+    DEBOUNCE_TYPE = custom
+    SRC += ./lib/keytrace_debounce.c
+    OPT_DEFS += -DKEYTRACE_ENABLE
+endif
 
 # https://zenn.dev/koron/articles/98324ab760e83a
 LTO_ENABLE = yes
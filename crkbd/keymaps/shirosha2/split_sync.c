@@ -0,0 +1,384 @@
+/********************************************************************************************************************************/
+/*  split_sync.c                                                                                                                */
+/*                                                                                                                              */
+/*  This file is for the split transaction scheduler.                                                                           */
+/*      - Luminous state master -> slave (on change, rate limited)                                                              */
+/*      - Slave telemetry slave -> master (chunked, in idle slack)                                                              */
+/*      - Per-transaction timing                                                                                                */
+/*      - Link loss / recovery                                                                                                  */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  QMK runs its own transactions (matrix, activity) inside the matrix scan, before housekeeping. The keymap transactions are   */
+/*  only started here, from housekeeping on the master, so the matrix sync of a pass always comes first, and at most one of     */
+/*  them is sent per pass, so a pass never carries more than one extra serial transfer.                                         */
+/*                                                                                                                              */
+/*  Priority, highest first:                                                                                                    */
+/*      State (Y_SYNC_ID_STATE) : the luminous state the slave follows (inspection mode, idle effect). Sent when it differs     */
+/*                                from the last state the slave acknowledged, at most every Y_SYNC_STATE_INTERVAL, held     */
+/*                                back while keys are in use for up to Y_SYNC_STATE_DEFER_MAX. Resent every                 */
+/*                                Y_SYNC_STATE_REFRESH so that a slave reset on its own catches up.                         */
+/*      Bulk  (Y_SYNC_ID_TLM)   : the slave telemetry frame, Y_SYNC_CHUNK_SIZE bytes per pass, only after Y_SYNC_QUIET_TIME  */
+/*                                without key activity and at most every Y_SYNC_CHUNK_INTERVAL. Typing pauses the transfer. */
+/*                                                                                                                              */
+/*  Link loss: QMK drops the link after SPLIT_MAX_CONNECTION_ERRORS failed scans (releasing the slave keys) and then retries    */
+/*  every SPLIT_CONNECTION_CHECK_TIMEOUT, both lowered in config.h. Its own transactions resync the matrix by checksum. When the */
+/*  link comes back, the keymap state is sent on the next pass, ahead of the rate limit and the typing hold-back, and the       */
+/*  telemetry frame starts over; then the incremental schedule above resumes.                                                   */
+/*                                                                                                                              */
+/*  Each transaction is timed with Timer1 (M_TIMER1_TICKS of luminous_common.h); the statistics are read by the raw HID         */
+/*  telemetry.                                                                                                                  */
+/********************************************************************************************************************************/
+
+/********************************************************************************************************************************/
+/* Includes                                                                                                                     */
+/********************************************************************************************************************************/
+#include "split_sync.h"
+#include "luminous_common.h"
+#include "luminous_control.h"
+#include "luminous_store.h"
+#include QMK_KEYBOARD_H
+#include "transactions.h"
+#ifdef RAW_ENABLE
+#include "telemetry.h"
+#endif /* RAW_ENABLE */
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_SYNC_QUIET_TIME       (50)        /* [ms,1] No key activity for this long: slack for bulk transfers     */
+#define Y_SYNC_STATE_INTERVAL   (100)       /* [ms,1] Minimum interval of the state transactions                  */
+#define Y_SYNC_STATE_DEFER_MAX  (500)       /* [ms,1] Longest hold-back of a changed state while typing           */
+#define Y_SYNC_STATE_REFRESH    (2000)      /* [ms,1] Resend the unchanged state                                  */
+#define Y_SYNC_CHUNK_SIZE       (8)         /* [byte] Bulk chunk (keeps one transfer short)                       */
+#define Y_SYNC_CHUNK_INTERVAL   (20)        /* [ms,1] Minimum interval of the bulk chunks                         */
+#define Y_SYNC_TLM_PERIOD       (1000)      /* [ms,1] Refresh period of the slave telemetry frame                 */
+
+/********************************************************************************************************************************/
+/*  Structures                                                                                                                  */
+/********************************************************************************************************************************/
+typedef struct {
+    uint8_t uc_insp_mode_flg;           /* Inspection mode flag                         */
+    uint8_t uc_effect_id;               /* Selected idle effect                         */
+} sync_state_t;                         /* Luminous state the slave follows             */
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static sync_stats_t zst_SYNC_stats[Y_SYNC_ID_NUM] = {0};            /* [-,-] Timing per transaction                  */
+static sync_state_t zst_SYNC_state_sent = {0};                      /* [-,-] State acknowledged by the slave         */
+static uint8_t zuc_SYNC_state_valid = Y_OFF;                        /* [-,-] zst_SYNC_state_sent is known            */
+static uint32_t zul_SYNC_state_time = 0;                            /* [ms,1] Last state transaction                 */
+static uint32_t zul_SYNC_state_change_time = 0;                     /* [ms,1] State first seen differing             */
+static sync_link_t zst_SYNC_link = {0};                             /* [-,-] Link history                            */
+static uint8_t zuc_SYNC_link_flg = Y_OFF;                           /* [-,-] Link up at the previous pass            */
+static uint32_t zul_SYNC_link_down_time = 0;                        /* [ms,1] Link lost                              */
+#ifdef RAW_ENABLE
+static tlm_frame_t zst_SYNC_tlm_frame = {0};                        /* [-,-] Slave: frame being sent, Master: received */
+static uint8_t zuc_SYNC_tlm_offset = 0;                             /* [byte] Next chunk of the frame                */
+static uint32_t zul_SYNC_tlm_time = 0;                              /* [ms,1] Start of the current frame             */
+static uint32_t zul_SYNC_chunk_time = 0;                            /* [ms,1] Last chunk                             */
+#endif /* RAW_ENABLE */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+static uint8_t m_sync_exec(uint8_t uc_id, int8_t c_transaction, uint8_t uc_in_size, const void *pv_in, uint8_t uc_out_size, void *pv_out);
+static uint8_t m_sync_link_task(uint32_t ul_now);
+static uint8_t m_sync_state_task(uint32_t ul_now, uint8_t uc_quiet_flg);
+static void m_sync_state_slave(uint8_t uc_in_size, const void *pv_in, uint8_t uc_out_size, void *pv_out);
+#ifdef RAW_ENABLE
+static uint8_t m_sync_tlm_task(uint32_t ul_now, uint8_t uc_quiet_flg);
+static void m_sync_tlm_slave(uint8_t uc_in_size, const void *pv_in, uint8_t uc_out_size, void *pv_out);
+#endif /* RAW_ENABLE */
+
+/****************************************************************/
+/*  m_sync_init                                                 */
+/*--------------------------------------------------------------*/
+/*  Register the slave handlers and start the time base.        */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init                                  */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_sync_init(void) {
+    M_TIMER1_INIT();                                                    /* Timer1 time base                 */
+    transaction_register_rpc(RPC_ID_USER_LMCTL_STATE, m_sync_state_slave);
+#ifdef RAW_ENABLE
+    transaction_register_rpc(RPC_ID_USER_TLM_CHUNK, m_sync_tlm_slave);
+#endif /* RAW_ENABLE */
+}
+
+/****************************************************************/
+/*  m_sync_task                                                 */
+/*--------------------------------------------------------------*/
+/*  Start the most urgent keymap transaction that is due.       */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping                                        */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_sync_task(void) {
+    const uint32_t xul_now = timer_read32();                            /* [ms] Pass timestamp              */
+    uint8_t uc_quiet_flg;                                               /* No recent key activity           */
+
+    if (!is_keyboard_master() || (m_sync_link_task(xul_now) == Y_OFF)) {
+        return;
+    }
+    uc_quiet_flg = (last_input_activity_elapsed() >= Y_SYNC_QUIET_TIME) ? Y_ON : Y_OFF;
+
+    if (m_sync_state_task(xul_now, uc_quiet_flg) == Y_ON) {
+        return;                                                         /* One transaction per pass         */
+    }
+#ifdef RAW_ENABLE
+    m_sync_tlm_task(xul_now, uc_quiet_flg);
+#endif /* RAW_ENABLE */
+}
+
+/****************************************************************/
+/*  m_sync_stats                                                */
+/*--------------------------------------------------------------*/
+/*  Timing of a scheduled transaction.                          */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Y_SYNC_ID_*>                                   */
+/*  Returns: <const sync_stats_t *> NULL if the id is unknown   */
+/****************************************************************/
+const sync_stats_t *m_sync_stats(uint8_t uc_id) {
+    if (uc_id >= Y_SYNC_ID_NUM) {
+        return NULL;
+    }
+    return &zst_SYNC_stats[uc_id];
+}
+
+/****************************************************************/
+/*  m_sync_link                                                 */
+/*--------------------------------------------------------------*/
+/*  Split link history.                                         */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters:                                                 */
+/*  Returns: <const sync_link_t *>                              */
+/****************************************************************/
+const sync_link_t *m_sync_link(void) {
+    return &zst_SYNC_link;
+}
+
+/****************************************************************/
+/*  m_sync_link_task                                            */
+/*--------------------------------------------------------------*/
+/*  Follow the link state, and schedule the full resync when    */
+/*  it comes back.                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping (master)                               */
+/*  Parameters: <Now [ms]>                                      */
+/*  Returns: <uint8_t> Y_ON: link up                            */
+/****************************************************************/
+static uint8_t m_sync_link_task(uint32_t ul_now) {
+    const uint8_t xuc_link_flg = is_transport_connected() ? Y_ON : Y_OFF;
+    uint32_t ul_outage;                                                 /* [ms] Outage just ended           */
+
+    if ((zuc_SYNC_link_flg == Y_ON) && (xuc_link_flg == Y_OFF)) {
+        M_CLIP_INC(zst_SYNC_link.us_downs, UINT16_MAX)
+        zul_SYNC_link_down_time = ul_now;
+    } else if ((zuc_SYNC_link_flg == Y_OFF) && (xuc_link_flg == Y_ON)) {
+        if (zst_SYNC_link.us_downs > 0) {                               /* Not the first connection         */
+            M_CLIP_INC(zst_SYNC_link.us_recoveries, UINT16_MAX)
+            ul_outage = TIMER_DIFF_32(ul_now, zul_SYNC_link_down_time);
+            zst_SYNC_link.us_outage_last = (ul_outage > UINT16_MAX) ? UINT16_MAX : (uint16_t)ul_outage;
+            if (zst_SYNC_link.us_outage_last > zst_SYNC_link.us_outage_max) {
+                zst_SYNC_link.us_outage_max = zst_SYNC_link.us_outage_last;
+            }
+        }
+        zuc_SYNC_state_valid = Y_OFF;                                   /* Full state on the next pass      */
+        zul_SYNC_state_time = ul_now - Y_SYNC_STATE_INTERVAL;
+        zul_SYNC_state_change_time = ul_now - Y_SYNC_STATE_DEFER_MAX;
+#ifdef RAW_ENABLE
+        zuc_SYNC_tlm_offset = 0;                                        /* Restart the telemetry frame      */
+#endif /* RAW_ENABLE */
+    }
+    zuc_SYNC_link_flg = xuc_link_flg;
+    return xuc_link_flg;
+}
+
+/****************************************************************/
+/*  m_sync_exec                                                 */
+/*--------------------------------------------------------------*/
+/*  Run a transaction and time it.                              */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Y_SYNC_ID_*>, <RPC id>, <In>, <Out>            */
+/*  Returns: <uint8_t> Y_ON: answered, Y_OFF: failed            */
+/****************************************************************/
+static uint8_t m_sync_exec(uint8_t uc_id, int8_t c_transaction, uint8_t uc_in_size, const void *pv_in, uint8_t uc_out_size, void *pv_out) {
+    sync_stats_t *pst_stats = &zst_SYNC_stats[uc_id];
+    const uint16_t xus_start = M_TIMER1_TICKS();                        /* [tick] Transaction start         */
+    const bool xb_done = transaction_rpc_exec(c_transaction, uc_in_size, pv_in, uc_out_size, pv_out);
+    const uint16_t xus_time = (uint16_t)(M_TIMER1_TICKS() - xus_start) / Y_TIMER1_TICKS_PER_US;   /* [us]     */
+
+    M_CLIP_INC(pst_stats->us_count, UINT16_MAX)
+    pst_stats->us_last = xus_time;
+    if (xus_time > pst_stats->us_max) {
+        pst_stats->us_max = xus_time;
+    }
+    if (!xb_done) {
+        M_CLIP_INC(pst_stats->us_fails, UINT16_MAX)
+        return Y_OFF;
+    }
+    return Y_ON;
+}
+
+/****************************************************************/
+/*  m_sync_state_task                                           */
+/*--------------------------------------------------------------*/
+/*  Send the luminous state if it changed, or to refresh it.    */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping (master)                               */
+/*  Parameters: <Now [ms]>, <Quiet flag>                        */
+/*  Returns: <uint8_t> Y_ON: a transaction was sent             */
+/****************************************************************/
+static uint8_t m_sync_state_task(uint32_t ul_now, uint8_t uc_quiet_flg) {
+    const lmsto_settings_t *xpst_settings = m_lmsto_settings();
+    const uint32_t xul_since_sent = TIMER_DIFF_32(ul_now, zul_SYNC_state_time);
+    sync_state_t st_state;                                              /* Current state                    */
+    uint8_t uc_due_flg = Y_OFF;                                         /* Send this pass                   */
+
+    if (xul_since_sent < Y_SYNC_STATE_INTERVAL) {
+        return Y_OFF;                                                   /* Rate limit                       */
+    }
+    st_state.uc_insp_mode_flg = xpst_settings->uc_insp_mode_flg;
+    st_state.uc_effect_id = xpst_settings->uc_effect_id;
+
+    if ((zuc_SYNC_state_valid == Y_ON) && (memcmp(&st_state, &zst_SYNC_state_sent, sizeof(st_state)) == 0)) {
+        zul_SYNC_state_change_time = ul_now;                            /* Unchanged                        */
+        uc_due_flg = (xul_since_sent >= Y_SYNC_STATE_REFRESH) ? uc_quiet_flg : Y_OFF;
+    } else if ((uc_quiet_flg == Y_ON)
+            || (TIMER_DIFF_32(ul_now, zul_SYNC_state_change_time) >= Y_SYNC_STATE_DEFER_MAX)) {
+        uc_due_flg = Y_ON;                                              /* Changed, not held back any more  */
+    }
+    if (uc_due_flg == Y_OFF) {
+        return Y_OFF;
+    }
+
+    zul_SYNC_state_time = ul_now;
+    if (m_sync_exec(Y_SYNC_ID_STATE, RPC_ID_USER_LMCTL_STATE, sizeof(st_state), &st_state, 0, NULL) == Y_ON) {
+        zst_SYNC_state_sent = st_state;
+        zuc_SYNC_state_valid = Y_ON;
+    }
+    zul_SYNC_state_change_time = ul_now;
+    return Y_ON;
+}
+
+/****************************************************************/
+/*  m_sync_state_slave                                          */
+/*--------------------------------------------------------------*/
+/*  Follow the luminous state of the master.                    */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: RPC_ID_USER_LMCTL_STATE (slave)                     */
+/*  Parameters: <In size>, <In>, <Out size>, <Out>              */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_sync_state_slave(uint8_t uc_in_size, const void *pv_in, uint8_t uc_out_size, void *pv_out) {
+    const sync_state_t *xpst_state = (const sync_state_t *)pv_in;
+
+    (void)uc_out_size;
+    (void)pv_out;
+    if (uc_in_size != sizeof(sync_state_t)) {
+        return;
+    }
+#if (OLED_DRIVER_ENABLE == 1)
+    m_lmctl_follow(xpst_state->uc_insp_mode_flg, xpst_state->uc_effect_id);
+#else
+    (void)xpst_state;
+#endif /* OLED_DRIVER_ENABLE */
+}
+
+#ifdef RAW_ENABLE
+/****************************************************************/
+/*  m_sync_tlm_task                                             */
+/*--------------------------------------------------------------*/
+/*  Pull the next chunk of the slave telemetry frame.           */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping (master)                               */
+/*  Parameters: <Now [ms]>, <Quiet flag>                        */
+/*  Returns: <uint8_t> Y_ON: a transaction was sent             */
+/****************************************************************/
+static uint8_t m_sync_tlm_task(uint32_t ul_now, uint8_t uc_quiet_flg) {
+    uint8_t uc_offset = zuc_SYNC_tlm_offset;                            /* [byte] Chunk to pull             */
+
+    if ((uc_quiet_flg == Y_OFF) || (TIMER_DIFF_32(ul_now, zul_SYNC_chunk_time) < Y_SYNC_CHUNK_INTERVAL)) {
+        return Y_OFF;                                                   /* No slack                         */
+    }
+    if ((uc_offset == 0) && (TIMER_DIFF_32(ul_now, zul_SYNC_tlm_time) < Y_SYNC_TLM_PERIOD)) {
+        return Y_OFF;                                                   /* Frame is fresh enough            */
+    }
+    if (uc_offset == 0) {
+        zul_SYNC_tlm_time = ul_now;
+    }
+
+    zul_SYNC_chunk_time = ul_now;
+    if (m_sync_exec(Y_SYNC_ID_TLM, RPC_ID_USER_TLM_CHUNK, sizeof(uc_offset), &uc_offset,
+                    Y_SYNC_CHUNK_SIZE, (uint8_t *)&zst_SYNC_tlm_frame + uc_offset) == Y_OFF) {
+        zuc_SYNC_tlm_offset = 0;                                        /* Start the frame over             */
+        return Y_ON;
+    }
+    uc_offset += Y_SYNC_CHUNK_SIZE;
+    if (uc_offset >= sizeof(tlm_frame_t)) {
+        m_tlm_slave_frame(&zst_SYNC_tlm_frame);                         /* Complete frame                   */
+        uc_offset = 0;
+    }
+    zuc_SYNC_tlm_offset = uc_offset;
+    return Y_ON;
+}
+
+/****************************************************************/
+/*  m_sync_tlm_slave                                            */
+/*--------------------------------------------------------------*/
+/*  Send a chunk of the telemetry frame, taking a new snapshot  */
+/*  on the first chunk so the master gets a consistent frame.   */
+/*--------------------------------------------------------------*/
+/*  Period: RPC_ID_USER_TLM_CHUNK (slave)                       */
+/*  Parameters: <In size>, <In>, <Out size>, <Out>              */
+/*  Returns:                                                    */
+/****************************************************************/
+static void m_sync_tlm_slave(uint8_t uc_in_size, const void *pv_in, uint8_t uc_out_size, void *pv_out) {
+    const uint8_t xuc_offset = *(const uint8_t *)pv_in;                 /* [byte] Requested chunk           */
+
+    if ((uc_in_size != 1) || (uc_out_size != Y_SYNC_CHUNK_SIZE) || (xuc_offset > sizeof(tlm_frame_t) - Y_SYNC_CHUNK_SIZE)) {
+        return;
+    }
+    if (xuc_offset == 0) {
+        m_tlm_snapshot(&zst_SYNC_tlm_frame);
+    }
+    memcpy(pv_out, (const uint8_t *)&zst_SYNC_tlm_frame + xuc_offset, Y_SYNC_CHUNK_SIZE);
+}
+
+_Static_assert(sizeof(tlm_frame_t) % Y_SYNC_CHUNK_SIZE == 0, "split_sync: the telemetry frame must split into whole chunks");
+#endif /* RAW_ENABLE */
@@ -0,0 +1,65 @@
+/********************************************************************************************************************************/
+/*  split_sync.h                                                                                                                */
+/*                                                                                                                              */
+/*  This file is for the split transaction scheduler.                                                                           */
+/*      - Luminous state master -> slave (on change, rate limited)                                                              */
+/*      - Slave telemetry slave -> master (chunked, in idle slack)                                                              */
+/*      - Per-transaction timing                                                                                                */
+/*      - Link loss / recovery                                                                                                  */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Includes                                                                                                                    */
+/********************************************************************************************************************************/
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_SYNC_ID_STATE         (0)         /* Luminous state                                                     */
+#define Y_SYNC_ID_TLM           (1)         /* Slave telemetry chunk                                              */
+#define Y_SYNC_ID_NUM           (2)         /* Number of scheduled transactions                                   */
+
+/********************************************************************************************************************************/
+/*  Structures                                                                                                                  */
+/********************************************************************************************************************************/
+typedef struct {
+    uint16_t us_count;                  /* Transactions sent                            */
+    uint16_t us_fails;                  /* Transactions not answered                    */
+    uint16_t us_last;                   /* [us] Duration of the last one                */
+    uint16_t us_max;                    /* [us] Longest one                             */
+} sync_stats_t;                         /* Timing of one scheduled transaction          */
+
+typedef struct {
+    uint16_t us_downs;                  /* Link lost                                    */
+    uint16_t us_recoveries;             /* Link back, slave state resent in full        */
+    uint16_t us_outage_last;            /* [ms] Length of the last outage               */
+    uint16_t us_outage_max;             /* [ms] Longest outage                          */
+} sync_link_t;                          /* Split link history                           */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+void m_sync_init(void);
+void m_sync_task(void);
+const sync_stats_t *m_sync_stats(uint8_t uc_id);
+const sync_link_t *m_sync_link(void);
@@ -0,0 +1,277 @@
+/********************************************************************************************************************************/
+/*  telemetry.c                                                                                                                 */
+/*                                                                                                                              */
+/*  This file is for the raw HID telemetry.                                                                                     */
+/*      - Performance counters                                                                                                  */
+/*      - Snapshot frame on request (tools/tlm_monitor.cpp)                                                                     */
+/*      - Key trace records and key statistics on request (KEYTRACE_ENABLE)                                                     */
+/*      - Slave half frame and split transaction timing on request (split_sync.c)                                               */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/********************************************************************************************************************************/
+/*  Overview                                                                                                                    */
+/*                                                                                                                              */
+/*  The counters are updated from the keymap hooks (housekeeping, OLED task, key records) and sent as one tlm_frame_t when the  */
+/*  host writes a Y_TLM_CMD_SNAPSHOT report. Nothing is sent unasked, so the telemetry costs a few increments per loop.         */
+/*                                                                                                                              */
+/*  Durations are taken from Timer1 (M_TIMER1_TICKS of luminous_common.h, shared with split_sync.c), and reported             */
+/*  in microseconds. The RGB task runs inside the QMK keyboard task and is only seen through the main loop time.                */
+/********************************************************************************************************************************/
+
+/********************************************************************************************************************************/
+/* Includes                                                                                                                     */
+/********************************************************************************************************************************/
+#include "telemetry.h"
+#include "luminous_common.h"
+#include QMK_KEYBOARD_H
+#include "raw_hid.h"
+#include "split_sync.h"
+#ifdef KEYTRACE_ENABLE
+#include "lib/keytrace.h"
+#endif
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_TLM_TICK_RANGE        (30)        /* [ms] Beyond this a 16-bit tick difference may have wrapped         */
+
+/********************************************************************************************************************************/
+/*  Macros                                                                                                                      */
+/********************************************************************************************************************************/
+#define M_TLM_SAT_ADD_MAX(us_max, ul_value) { \
+    if ((ul_value) > (us_max)) { (us_max) = ((ul_value) > UINT16_MAX) ? UINT16_MAX : (uint16_t)(ul_value); } \
+}
+
+/********************************************************************************************************************************/
+/*  Variables                                                                                                                   */
+/********************************************************************************************************************************/
+static tlm_frame_t zst_TLM_frame = {0};                             /* [-,-] Counters, sent as is                    */
+static uint16_t zus_TLM_loop_ticks = 0;                             /* [tick] Timer1 at the previous loop pass       */
+static uint16_t zus_TLM_loop_ms = 0;                                /* [ms,1] timer_read() at the previous loop pass */
+static uint16_t zus_TLM_oled_ticks = 0;                             /* [tick] Timer1 at the OLED task start          */
+static uint16_t zus_TLM_oled_ms = 0;                                /* [ms,1] timer_read() at the OLED task start    */
+static uint8_t zuc_TLM_link_flg = Y_OFF;                            /* [-,-] Split transport connected               */
+static tlm_frame_t zst_TLM_slave_frame = {0};                       /* [-,-] Last frame of the slave half            */
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+static uint32_t m_tlm_elapsed_us(uint16_t us_start_ticks, uint16_t us_start_ms);
+
+/****************************************************************/
+/*  m_tlm_init                                                  */
+/*--------------------------------------------------------------*/
+/*  Start the time base.                                        */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: keyboard_post_init                                  */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_tlm_init(void) {
+    M_TIMER1_INIT();                                                    /* Timer1 time base                 */
+    zst_TLM_frame.uc_command = Y_TLM_CMD_SNAPSHOT;
+    zst_TLM_frame.uc_version = Y_TLM_VERSION;
+    zus_TLM_loop_ticks = M_TIMER1_TICKS();
+    zus_TLM_loop_ms = timer_read();
+}
+
+/****************************************************************/
+/*  m_tlm_loop                                                  */
+/*--------------------------------------------------------------*/
+/*  Count a main loop pass and time it.                         */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: housekeeping                                        */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_tlm_loop(void) {
+    const uint32_t xul_loop_us = m_tlm_elapsed_us(zus_TLM_loop_ticks, zus_TLM_loop_ms);    /* [us] Last pass   */
+    uint8_t uc_link_flg;                                                /* Split transport connected        */
+
+    zus_TLM_loop_ticks = M_TIMER1_TICKS();
+    zus_TLM_loop_ms = timer_read();
+
+    zst_TLM_frame.ul_scans++;
+    M_TLM_SAT_ADD_MAX(zst_TLM_frame.us_loop_max, xul_loop_us)
+
+    uc_link_flg = is_transport_connected() ? Y_ON : Y_OFF;
+    if ((zuc_TLM_link_flg == Y_ON) && (uc_link_flg == Y_OFF)) {
+        M_CLIP_INC(zst_TLM_frame.us_split_drops, UINT16_MAX)            /* Link lost                        */
+    }
+    zuc_TLM_link_flg = uc_link_flg;
+}
+
+/****************************************************************/
+/*  m_tlm_oled_begin / m_tlm_oled_end                           */
+/*--------------------------------------------------------------*/
+/*  Time the OLED task.                                         */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: OLED_UPDATE_INTERVAL                                */
+/*  Parameters:                                                 */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_tlm_oled_begin(void) {
+    zus_TLM_oled_ticks = M_TIMER1_TICKS();
+    zus_TLM_oled_ms = timer_read();
+}
+
+void m_tlm_oled_end(void) {
+    const uint32_t xul_oled_us = m_tlm_elapsed_us(zus_TLM_oled_ticks, zus_TLM_oled_ms);    /* [us] OLED task   */
+
+    zst_TLM_frame.ul_oled_calls++;
+    zst_TLM_frame.ul_oled_time += xul_oled_us;
+    M_TLM_SAT_ADD_MAX(zst_TLM_frame.us_oled_max, xul_oled_us)
+}
+
+/****************************************************************/
+/*  m_tlm_record                                                */
+/*--------------------------------------------------------------*/
+/*  Count the key events.                                       */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: key record is updated                               */
+/*  Parameters: keyrecord_t *record                             */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_tlm_record(keyrecord_t *record) {
+    (void)record;
+    zst_TLM_frame.ul_key_events++;
+}
+
+/****************************************************************/
+/*  m_tlm_snapshot                                              */
+/*--------------------------------------------------------------*/
+/*  Copy the counters into a frame and restart the peaks.       */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: raw HID request, slave telemetry pull               */
+/*  Parameters: tlm_frame_t *pst_frame                          */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_tlm_snapshot(tlm_frame_t *pst_frame) {
+    zst_TLM_frame.ul_uptime = timer_read32();
+    zst_TLM_frame.uc_flags = (is_keyboard_master() ? Y_TLM_FLG_MASTER : 0)
+                           | ((zuc_TLM_link_flg == Y_ON) ? Y_TLM_FLG_SPLIT_LINK : 0);
+    memcpy(pst_frame, &zst_TLM_frame, sizeof(tlm_frame_t));
+
+    zst_TLM_frame.us_oled_max = 0;                                      /* Restart the peaks                */
+    zst_TLM_frame.us_loop_max = 0;
+}
+
+/****************************************************************/
+/*  m_tlm_slave_frame                                           */
+/*--------------------------------------------------------------*/
+/*  Keep the last frame pulled from the slave half.             */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: slave telemetry pull complete (split_sync.c)        */
+/*  Parameters: const tlm_frame_t *pst_frame                    */
+/*  Returns:                                                    */
+/****************************************************************/
+void m_tlm_slave_frame(const tlm_frame_t *pst_frame) {
+    memcpy(&zst_TLM_slave_frame, pst_frame, sizeof(tlm_frame_t));
+}
+
+/****************************************************************/
+/*  raw_hid_receive                                             */
+/*--------------------------------------------------------------*/
+/*  Answer a telemetry request from the host.                   */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period: raw HID report received                             */
+/*  Parameters: uint8_t *data, uint8_t length                   */
+/*  Returns:                                                    */
+/****************************************************************/
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    uint8_t uc_id;                                                      /* Scheduled transaction            */
+#ifdef KEYTRACE_ENABLE
+    keytrace_stats_t st_stats;                                          /* Statistics of the requested key  */
+#endif
+
+    if ((length >= Y_TLM_FRAME_SIZE) && (data[0] == Y_TLM_CMD_SNAPSHOT)) {
+        m_tlm_snapshot((tlm_frame_t *)data);
+        raw_hid_send(data, length);
+    } else if ((length >= Y_TLM_FRAME_SIZE) && (data[0] == Y_TLM_CMD_SLAVE)) {
+        memcpy(data, &zst_TLM_slave_frame, Y_TLM_FRAME_SIZE);           /* Version 0 until the first pull   */
+        data[0] = Y_TLM_CMD_SLAVE;
+        raw_hid_send(data, length);
+    } else if ((length >= Y_TLM_SPLIT_HEADER_SIZE + (Y_SYNC_ID_NUM * sizeof(sync_stats_t)) + sizeof(sync_link_t))
+            && (data[0] == Y_TLM_CMD_SPLIT)) {
+        memset(data, 0, length);
+        data[0] = Y_TLM_CMD_SPLIT;
+        data[1] = Y_SYNC_ID_NUM;
+        for (uc_id = 0; uc_id < Y_SYNC_ID_NUM; uc_id++) {
+            memcpy(&data[Y_TLM_SPLIT_HEADER_SIZE + (uc_id * sizeof(sync_stats_t))], m_sync_stats(uc_id), sizeof(sync_stats_t));
+        }
+        memcpy(&data[Y_TLM_SPLIT_HEADER_SIZE + (Y_SYNC_ID_NUM * sizeof(sync_stats_t))], m_sync_link(), sizeof(sync_link_t));
+        raw_hid_send(data, length);
+#ifdef KEYTRACE_ENABLE
+    } else if ((length >= Y_TLM_TRACE_HEADER_SIZE) && (data[0] == Y_TLM_CMD_TRACE)) {
+        const uint16_t xus_dropped = keytrace_dropped();
+
+        memset(data, 0, length);
+        data[0] = Y_TLM_CMD_TRACE;
+        data[1] = keytrace_read(&data[Y_TLM_TRACE_HEADER_SIZE], length - Y_TLM_TRACE_HEADER_SIZE);
+        data[2] = (uint8_t)xus_dropped;
+        data[3] = (uint8_t)(xus_dropped >> 8);
+        raw_hid_send(data, length);
+    } else if ((length >= 13) && (data[0] == Y_TLM_CMD_KEY_STATS)
+            && keytrace_key_stats(data[1], data[2], &st_stats)) {
+        memset(&data[3], 0, length - 3);
+        data[3] = (uint8_t)st_stats.presses;
+        data[4] = (uint8_t)(st_stats.presses >> 8);
+        data[5] = (uint8_t)st_stats.hold_ms;
+        data[6] = (uint8_t)(st_stats.hold_ms >> 8);
+        data[7] = (uint8_t)st_stats.interval_ms;
+        data[8] = (uint8_t)(st_stats.interval_ms >> 8);
+        data[9] = st_stats.bounce;
+        data[10] = keytrace_bounce_min_gap();
+        data[11] = st_stats.repress;
+        data[12] = keytrace_repress_min_gap();
+        raw_hid_send(data, length);
+#endif /* KEYTRACE_ENABLE */
+    } else {
+        memset(data, 0, length);
+        data[0] = Y_TLM_CMD_UNKNOWN;
+        raw_hid_send(data, length);
+    }
+}
+
+/****************************************************************/
+/*  m_tlm_elapsed_us                                            */
+/*--------------------------------------------------------------*/
+/*  Time since a (Timer1, timer_read) pair.                     */
+/*                                                              */
+/*--------------------------------------------------------------*/
+/*  Period:                                                     */
+/*  Parameters: <Start [tick]>, <Start [ms]>                    */
+/*  Returns: <uint32_t> [us] Elapsed time                       */
+/****************************************************************/
+static uint32_t m_tlm_elapsed_us(uint16_t us_start_ticks, uint16_t us_start_ms) {
+    const uint16_t xus_elapsed_ms = timer_elapsed(us_start_ms);
+
+    if (xus_elapsed_ms >= Y_TLM_TICK_RANGE) {
+        return (uint32_t)xus_elapsed_ms * 1000;                         /* Ticks may have wrapped           */
+    }
+    return (uint16_t)(M_TIMER1_TICKS() - us_start_ticks) / Y_TIMER1_TICKS_PER_US;
+}
@@ -0,0 +1,92 @@
+/********************************************************************************************************************************/
+/*  telemetry.h                                                                                                                 */
+/*                                                                                                                              */
+/*  This file is for the raw HID telemetry.                                                                                     */
+/*      - Performance counters                                                                                                  */
+/*      - Snapshot frame on request (tools/tlm_monitor.cpp)                                                                     */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/********************************************************************************************************************************/
+/*  Includes                                                                                                                    */
+/********************************************************************************************************************************/
+#include QMK_KEYBOARD_H
+
+/********************************************************************************************************************************/
+/*  Defines                                                                                                                     */
+/********************************************************************************************************************************/
+#define Y_TLM_FRAME_SIZE        (32)        /* [byte] Raw HID report size (RAW_EPSIZE)                            */
+#define Y_TLM_VERSION           (1)         /* Frame layout version                                               */
+#define Y_TLM_CMD_SNAPSHOT      (0x01)      /* Request: send the counters, restart the peak values                */
+#define Y_TLM_CMD_TRACE         (0x02)      /* Request: send the oldest key trace records (lib/keytrace.h)        */
+#define Y_TLM_CMD_KEY_STATS     (0x03)      /* Request: send the statistics of the key at (data[1], data[2])      */
+#define Y_TLM_CMD_SLAVE         (0x04)      /* Request: send the last snapshot of the slave half                  */
+#define Y_TLM_CMD_SPLIT         (0x05)      /* Request: send the split transaction timing (split_sync.h)          */
+#define Y_TLM_CMD_UNKNOWN       (0xFF)      /* Response to an unknown request                                     */
+
+/* Trace response: command, length, dropped records (16 bits), records */
+#define Y_TLM_TRACE_HEADER_SIZE (4)         /* [byte] Header of a trace response                                  */
+/* Key statistics response: command, row, col, presses, hold [ms], interval [ms] (16 bits each), */
+/*                          bounce count (0..15), shortest bounce gap of all keys [ms] (255: none), */
+/*                          re-press count (0..15), shortest re-press gap of all keys [ms] (255: none) */
+/* Split response: command, number of transactions, reserved (2), one sync_stats_t each, then sync_link_t */
+#define Y_TLM_SPLIT_HEADER_SIZE (4)         /* [byte] Header of a split response                                  */
+
+#define Y_TLM_FLG_MASTER        (Y_BIT0)    /* Half connected to USB                                              */
+#define Y_TLM_FLG_SPLIT_LINK    (Y_BIT1)    /* Split transport connected                                          */
+
+/********************************************************************************************************************************/
+/*  Structures                                                                                                                  */
+/********************************************************************************************************************************/
+/****************************************************************/
+/* Snapshot frame (little endian, 32 bytes)                     */
+/*  Counters only increase (wrap at 2^32), the host takes the   */
+/*  difference of two snapshots for rates. Peaks (*_max) are    */
+/*  restarted by every snapshot.                                */
+/****************************************************************/
+typedef struct __attribute__((packed)) {
+    uint8_t uc_command;                 /*  0: Y_TLM_CMD_SNAPSHOT                       */
+    uint8_t uc_version;                 /*  1: Y_TLM_VERSION                            */
+    uint8_t uc_flags;                   /*  2: Y_TLM_FLG_*                              */
+    uint8_t uc_reserved;                /*  3: 0                                        */
+    uint32_t ul_uptime;                 /*  4: [ms] timer_read32()                      */
+    uint32_t ul_scans;                  /*  8: Main loop passes (matrix scans)          */
+    uint32_t ul_key_events;             /* 12: Key presses and releases                 */
+    uint32_t ul_oled_calls;             /* 16: OLED task calls                          */
+    uint32_t ul_oled_time;              /* 20: [us] Total time in the OLED task         */
+    uint16_t us_oled_max;               /* 24: [us] Longest OLED task                   */
+    uint16_t us_loop_max;               /* 26: [us] Longest main loop pass              */
+    uint16_t us_split_drops;            /* 28: Split transport disconnections           */
+    uint16_t us_reserved;               /* 30: 0                                        */
+} tlm_frame_t;
+
+_Static_assert(sizeof(tlm_frame_t) == Y_TLM_FRAME_SIZE, "telemetry: the frame must be one raw HID report");
+
+/********************************************************************************************************************************/
+/*  Functions                                                                                                                   */
+/********************************************************************************************************************************/
+void m_tlm_init(void);
+void m_tlm_loop(void);
+void m_tlm_oled_begin(void);
+void m_tlm_oled_end(void);
+void m_tlm_record(keyrecord_t *record);
+void m_tlm_snapshot(tlm_frame_t *pst_frame);
+void m_tlm_slave_frame(const tlm_frame_t *pst_frame);
@@ -0,0 +1,299 @@
+/********************************************************************************************************************************/
+/*  anim_encode.cpp                                                                                                             */
+/*                                                                                                                              */
+/*  Encoder of the OLED animations played by luminous_anim.c.                                                                   */
+/*      - Reads the frames as PBM images (P1 or P4)                                                                             */
+/*      - Stores each frame as XOR-delta runs against the previous one, in the driver buffer layout                             */
+/*      - Writes a PROGMEM array to include in the keymap.c, and the sizes to stderr                                            */
+/*                                                                                                                              */
+/*  Build:  g++ -std=c++17 -O2 -Wall -o anim_encode anim_encode.cpp                                                             */
+/*  Usage:  anim_encode [-n <name>] [-t <ms>] [--loop] [--landscape] <frame.pbm>... > anim.h                                    */
+/*      -n <name>         array name (default Xuc_boot_anim, the boot animation of luminous_control.c #1201)                    */
+/*      -t <ms>           time per frame (default 125)                                                                          */
+/*      --loop            play forever: append the delta from the last frame back to the first                                  */
+/*      --landscape       frames are 128 x 32 as the driver sees them, instead of the 32 x 128 portrait canvas of the effects   */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+/* Must match luminous_anim.h */
+constexpr uint8_t     kFlagLoop   = 0x01;
+constexpr uint8_t     kSkipExt    = 0xFF;
+constexpr std::size_t kRunMax     = 255;
+constexpr std::size_t kFrameMax   = 255;
+
+/* Driver buffer of the 128 x 32 OLED: byte (page * 128 + column), bit (row % 8) */
+constexpr int         kCols       = 128;
+constexpr int         kPages      = 4;
+constexpr std::size_t kBufferSize = kCols * kPages;
+
+/* A run header costs 2 bytes, so gaps up to this size are cheaper inline */
+constexpr std::size_t kGapInline  = 2;
+
+using Buffer = std::array<uint8_t, kBufferSize>;
+
+struct Options {
+    std::string              name      = "Xuc_boot_anim";
+    int                      frame_ms  = 125;
+    bool                     loop      = false;
+    bool                     landscape = false;
+    std::vector<std::string> frames;
+};
+
+struct Bitmap {
+    int               width  = 0;
+    int               height = 0;
+    std::vector<bool> pixels; /* row major, true: lit */
+};
+
+/* Next header token of a PBM file, skipping blanks and comments */
+bool pbm_token(const std::string &data, std::size_t &at, std::string &token) {
+    token.clear();
+    while (at < data.size()) {
+        if (data[at] == '#') {
+            while (at < data.size() && data[at] != '\n') {
+                at++;
+            }
+        } else if (std::isspace(static_cast<unsigned char>(data[at]))) {
+            at++;
+        } else {
+            break;
+        }
+    }
+    while (at < data.size() && !std::isspace(static_cast<unsigned char>(data[at])) && data[at] != '#') {
+        token += data[at++];
+    }
+    return !token.empty();
+}
+
+bool read_pbm(const std::string &path, Bitmap &bmp) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::size_t at = 0;
+    std::string magic, w, h;
+
+    if (!pbm_token(data, at, magic) || (magic != "P1" && magic != "P4") || !pbm_token(data, at, w) || !pbm_token(data, at, h)) {
+        return false;
+    }
+    bmp.width  = std::atoi(w.c_str());
+    bmp.height = std::atoi(h.c_str());
+    if (bmp.width <= 0 || bmp.height <= 0) {
+        return false;
+    }
+    bmp.pixels.assign(static_cast<std::size_t>(bmp.width) * bmp.height, false);
+
+    if (magic == "P1") {
+        for (std::size_t i = 0; i < bmp.pixels.size(); i++) {
+            while (at < data.size() && data[at] != '0' && data[at] != '1') {
+                if (data[at] == '#') {
+                    while (at < data.size() && data[at] != '\n') {
+                        at++;
+                    }
+                } else {
+                    at++;
+                }
+            }
+            if (at >= data.size()) {
+                return false;
+            }
+            bmp.pixels[i] = data[at++] == '1';
+        }
+    } else {
+        const std::size_t stride = (static_cast<std::size_t>(bmp.width) + 7) / 8;
+        at++; /* single blank after the height */
+        if (data.size() < at + stride * bmp.height) {
+            return false;
+        }
+        for (int y = 0; y < bmp.height; y++) {
+            for (int x = 0; x < bmp.width; x++) {
+                const uint8_t byte = static_cast<uint8_t>(data[at + y * stride + x / 8]);
+                bmp.pixels[static_cast<std::size_t>(y) * bmp.width + x] = (byte >> (7 - x % 8)) & 1;
+            }
+        }
+    }
+    return true;
+}
+
+/* Same layout as M_LMCTL_OLED_INDEX / M_LMCTL_OLED_MASK of luminous_control.c for the portrait canvas */
+bool to_buffer(const Bitmap &bmp, bool landscape, Buffer &buf) {
+    const int width  = landscape ? kCols : kPages * 8;
+    const int height = landscape ? kPages * 8 : kCols;
+
+    if (bmp.width != width || bmp.height != height) {
+        return false;
+    }
+    buf.fill(0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!bmp.pixels[static_cast<std::size_t>(y) * width + x]) {
+                continue;
+            }
+            if (landscape) {
+                buf[(y / 8) * kCols + x] |= static_cast<uint8_t>(1U << (y % 8));
+            } else {
+                buf[(x / 8) * kCols + (kCols - 1 - y)] |= static_cast<uint8_t>(1U << (x % 8));
+            }
+        }
+    }
+    return true;
+}
+
+/* Runs of (cur ^ prev), see luminous_anim.h */
+void encode_delta(const Buffer &prev, const Buffer &cur, std::vector<uint8_t> &out, std::size_t &changed) {
+    std::size_t cursor = 0; /* first byte after the last run */
+    std::size_t i      = 0;
+
+    changed = 0;
+    while (i < kBufferSize) {
+        if (prev[i] == cur[i]) {
+            i++;
+            continue;
+        }
+        std::size_t end = i; /* one past the run */
+        while (end < kBufferSize && end - i < kRunMax) {
+            if (prev[end] != cur[end]) {
+                end++;
+                continue;
+            }
+            std::size_t next = end; /* next change after a short gap */
+            while (next < kBufferSize && next - end <= kGapInline && prev[next] == cur[next]) {
+                next++;
+            }
+            if (next < kBufferSize && next - end <= kGapInline && next - i < kRunMax) {
+                end = next;
+            } else {
+                break;
+            }
+        }
+
+        std::size_t skip = i - cursor;
+        while (skip >= kSkipExt) {
+            out.push_back(kSkipExt);
+            skip -= kSkipExt;
+        }
+        out.push_back(static_cast<uint8_t>(skip));
+        out.push_back(static_cast<uint8_t>(end - i));
+        for (std::size_t k = i; k < end; k++) {
+            out.push_back(static_cast<uint8_t>(prev[k] ^ cur[k]));
+            changed += prev[k] != cur[k];
+        }
+        cursor = end;
+        i      = end;
+    }
+    out.push_back(0); /* end of the frame */
+    out.push_back(0);
+}
+
+void usage() {
+    std::fprintf(stderr, "usage: anim_encode [-n <name>] [-t <ms>] [--loop] [--landscape] <frame.pbm>...\n");
+}
+
+bool parse_args(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            opt.name = argv[++i];
+        } else if (arg == "-t" && i + 1 < argc) {
+            opt.frame_ms = std::atoi(argv[++i]);
+        } else if (arg == "--loop") {
+            opt.loop = true;
+        } else if (arg == "--landscape") {
+            opt.landscape = true;
+        } else if (!arg.empty() && arg[0] != '-') {
+            opt.frames.push_back(arg);
+        } else {
+            return false;
+        }
+    }
+    return !opt.frames.empty() && opt.frames.size() <= kFrameMax && opt.frame_ms > 0 && opt.frame_ms <= 0xFFFF;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    std::vector<Buffer> buffers;
+    for (const std::string &path : opt.frames) {
+        Bitmap bmp;
+        Buffer buf;
+        if (!read_pbm(path, bmp)) {
+            std::fprintf(stderr, "anim_encode: %s: not a readable PBM image\n", path.c_str());
+            return 1;
+        }
+        if (!to_buffer(bmp, opt.landscape, buf)) {
+            std::fprintf(stderr, "anim_encode: %s: %dx%d, expected %s\n", path.c_str(), bmp.width, bmp.height,
+                         opt.landscape ? "128x32" : "32x128");
+            return 1;
+        }
+        buffers.push_back(buf);
+    }
+
+    std::vector<uint8_t> out = {
+        static_cast<uint8_t>(buffers.size()),
+        static_cast<uint8_t>(opt.loop ? kFlagLoop : 0),
+        static_cast<uint8_t>(opt.frame_ms & 0xFF),
+        static_cast<uint8_t>(opt.frame_ms >> 8),
+    };
+    Buffer      prev{};
+    std::size_t changed_total = 0;
+    for (std::size_t f = 0; f < buffers.size(); f++) {
+        const std::size_t before = out.size();
+        std::size_t       changed;
+        encode_delta(prev, buffers[f], out, changed);
+        changed_total += changed;
+        std::fprintf(stderr, "frame %3zu: %4zu bytes changed, %4zu bytes stored\n", f, changed, out.size() - before);
+        prev = buffers[f];
+    }
+    if (opt.loop) {
+        const std::size_t before = out.size();
+        std::size_t       changed;
+        encode_delta(prev, buffers[0], out, changed);
+        std::fprintf(stderr, "loop     : %4zu bytes changed, %4zu bytes stored\n", changed, out.size() - before);
+    }
+    std::fprintf(stderr, "%zu frames: %zu bytes (raw %zu), %zu bytes changed\n", buffers.size(), out.size(),
+                 buffers.size() * kBufferSize, changed_total);
+
+    std::printf("/* Generated by tools/anim_encode.cpp: %zu frames, %d ms per frame%s, %zu bytes */\n", buffers.size(), opt.frame_ms,
+                opt.loop ? ", loop" : "", out.size());
+    std::printf("const uint8_t PROGMEM %s[] = {\n", opt.name.c_str());
+    for (std::size_t i = 0; i < out.size(); i++) {
+        std::printf("%s0x%02x,%s", (i % 16 == 0) ? "    " : "", out[i], (i % 16 == 15 || i + 1 == out.size()) ? "\n" : " ");
+    }
+    std::printf("};\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+/********************************************************************************************************************************/
+/*  anim_test.c                                                                                                                 */
+/*                                                                                                                              */
+/*  Round trip of the boot animation: the PBM frames, encoded by anim_encode.cpp into boot_anim.h, played by luminous_anim.c.   */
+/*      - Every frame decoded into the driver buffer equals its PBM frame, through two loops                                    */
+/*      - A frame is applied once its time is up, at most Y_LMAN_CATCH_UP_MAX per call                                          */
+/*                                                                                                                              */
+/*  Build:  cc -std=c11 -Wall -Ihost -I.. '-DQMK_KEYBOARD_H="keyboard.h"' -o anim_test anim_test.c ../luminous_anim.c           */
+/*  Usage:  anim_test           (from tools/, exit status 0 when every check passes)                                            */
+/*  Check:  anim_encode --loop fixtures/boot_anim/f*.pbm | diff - ../boot_anim.h                                                */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "luminous_anim.h"
+#include "boot_anim.h"
+
+#define FRAME_MAX 16
+#define COLS 128
+#define PAGES 4
+#define WIDTH (PAGES * 8) /* portrait canvas, 32 x 128 */
+#define HEIGHT COLS
+
+uint32_t host_timer_ms;
+
+static uint8_t  oled[OLED_MATRIX_SIZE];
+static uint8_t  frames[FRAME_MAX][OLED_MATRIX_SIZE];
+static unsigned writes;
+
+oled_buffer_reader_t oled_read_raw(uint16_t start_index) {
+    oled_buffer_reader_t reader = {&oled[start_index], (uint16_t)(OLED_MATRIX_SIZE - start_index)};
+    return reader;
+}
+
+void oled_write_raw_byte(const char data, uint16_t index) {
+    oled[index] = (uint8_t)data;
+    writes++;
+}
+
+/* P4 frame into the driver buffer, the layout of anim_encode.cpp to_buffer() */
+static bool load_frame(const char *path, uint8_t *buf) {
+    FILE *in = fopen(path, "rb");
+    int   width, height;
+    bool  ok;
+
+    if (in == NULL) {
+        return false;
+    }
+    ok = fscanf(in, "P4 %d %d", &width, &height) == 2 && width == WIDTH && height == HEIGHT && fgetc(in) != EOF;
+    memset(buf, 0, OLED_MATRIX_SIZE);
+    for (int y = 0; ok && y < HEIGHT; y++) {
+        for (int xb = 0; ok && xb < WIDTH / 8; xb++) {
+            const int byte = fgetc(in);
+
+            ok = byte != EOF;
+            for (int bit = 0; ok && bit < 8; bit++) {
+                const int x = xb * 8 + bit;
+
+                if ((byte >> (7 - bit)) & 1) {
+                    buf[(x / 8) * COLS + (COLS - 1 - y)] |= (uint8_t)(1U << (x % 8));
+                }
+            }
+        }
+    }
+    fclose(in);
+    return ok;
+}
+
+static int report(const char *name, bool ok) {
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", name);
+    return !ok;
+}
+
+int main(void) {
+    const uint8_t  xuc_frame_num  = Xuc_boot_anim[0];
+    const uint16_t xus_frame_time = (uint16_t)(Xuc_boot_anim[2] | (Xuc_boot_anim[3] << 8));
+    bool           ok;
+    int            failures = 0;
+
+    if (xuc_frame_num == 0 || xuc_frame_num > FRAME_MAX) {
+        return report("frame count", false);
+    }
+    for (uint8_t f = 0; f < xuc_frame_num; f++) {
+        char path[64];
+
+        snprintf(path, sizeof(path), "fixtures/boot_anim/f%u.pbm", f);
+        if (!load_frame(path, frames[f])) {
+            printf("FAIL %s: not a 32x128 P4 image\n", path);
+            return 1;
+        }
+    }
+    printf("     %u frames, %u ms per frame, %zu bytes%s\n", xuc_frame_num, xus_frame_time, sizeof(Xuc_boot_anim),
+           (Xuc_boot_anim[1] & Y_LMAN_FLAG_LOOP) ? ", loop" : "");
+
+    /* Frame by frame over two loops */
+    m_lman_start(Xuc_boot_anim);
+    ok = memcmp(oled, frames[0], OLED_MATRIX_SIZE) == 0;
+    for (unsigned i = 1; ok && i <= 2u * xuc_frame_num; i++) {
+        ok = m_lman_task(xus_frame_time - 1) == Y_ON && memcmp(oled, frames[(i - 1) % xuc_frame_num], OLED_MATRIX_SIZE) == 0;
+        ok = ok && m_lman_task(1) == Y_ON && memcmp(oled, frames[i % xuc_frame_num], OLED_MATRIX_SIZE) == 0;
+    }
+    failures += report("every frame decodes to its PBM, through two loops", ok);
+
+    /* Far behind: two frames at most, the rest of the time dropped */
+    memset(oled, 0, sizeof(oled));
+    m_lman_start(Xuc_boot_anim);
+    writes = 0;
+    ok     = m_lman_task(10 * xus_frame_time) == Y_ON && memcmp(oled, frames[2 % xuc_frame_num], OLED_MATRIX_SIZE) == 0;
+    ok     = ok && m_lman_task(xus_frame_time - 1) == Y_ON && memcmp(oled, frames[2 % xuc_frame_num], OLED_MATRIX_SIZE) == 0;
+    failures += report("catch up two frames at most after a long stall", ok && writes != 0);
+
+    m_lman_stop();
+    failures += report("stopped", m_lman_task(xus_frame_time) == Y_OFF);
+    return failures != 0;
+}
@@ -0,0 +1,159 @@
+/********************************************************************************************************************************/
+/*  bounce_test.c                                                                                                               */
+/*                                                                                                                              */
+/*  Host test of the chatter statistics of lib/keytrace_debounce.c and lib/keytrace.c, one half scanned every millisecond.      */
+/*      - Debounce : the matrix is reported DEBOUNCE ms after its last raw change, as QMK's sym_defer_g                         */
+/*      - Bounce   : raw changes after the first one in the window counted per key, with the shortest gap, saturating at 15     */
+/*      - Halves   : the rows of the right half land on the rows of the whole matrix                                            */
+/*      - Re-press : a press within KEYTRACE_REPRESS_MS of the release counted apart, from the key events                       */
+/*                                                                                                                              */
+/*  Build:  cc -std=c11 -Wall -Ihost -I../../../lib -o bounce_test bounce_test.c ../../../lib/keytrace_debounce.c               */
+/*              ../../../lib/keytrace.c                                                                                         */
+/*  Usage:  bounce_test         (exit status 0 when every check passes)                                                         */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "debounce.h"
+#include "keytrace.h"
+
+#define DEBOUNCE_MS 5 /* DEBOUNCE of keytrace_debounce.c */
+#define HALF_ROWS (MATRIX_ROWS / 2)
+
+uint32_t host_timer_ms;
+
+static bool         left = true;
+static matrix_row_t raw[HALF_ROWS];
+static matrix_row_t previous[HALF_ROWS];
+static matrix_row_t cooked[HALF_ROWS];
+static uint32_t     reported_at; /* last time the cooked matrix changed */
+
+bool is_keyboard_left(void) { return left; }
+
+/* One scan per millisecond, changed as the QMK matrix scan sets it */
+static void scan(unsigned ms) {
+    for (unsigned i = 0; i < ms; i++) {
+        const bool changed = memcmp(raw, previous, sizeof(raw)) != 0;
+
+        memcpy(previous, raw, sizeof(raw));
+        if (debounce(raw, cooked, HALF_ROWS, changed)) {
+            reported_at = host_timer_ms;
+        }
+        host_timer_ms++;
+    }
+}
+
+static void set_key(uint8_t row, uint8_t col, bool closed) {
+    if (closed) {
+        raw[row] |= (matrix_row_t)(1U << col);
+    } else {
+        raw[row] &= (matrix_row_t)~(1U << col);
+    }
+}
+
+/* Closed, open, closed... every gap ms, ending closed (pressed) or open (released) */
+static void bounce(uint8_t row, uint8_t col, unsigned edges, unsigned gap, bool pressed) {
+    for (unsigned i = 0; i < edges; i++) {
+        set_key(row, col, ((edges - 1 - i) & 1) ? !pressed : pressed);
+        scan(gap);
+    }
+}
+
+static keytrace_stats_t stats_of(uint8_t row, uint8_t col) {
+    keytrace_stats_t stats;
+
+    keytrace_key_stats(row, col, &stats);
+    return stats;
+}
+
+static void event(uint8_t row, uint8_t col, bool pressed) {
+    keyrecord_t record = {{{col, row}, pressed, (uint16_t)host_timer_ms}};
+
+    keytrace_record(&record);
+}
+
+static int report(const char *name, bool ok) {
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", name);
+    return !ok;
+}
+
+int main(void) {
+    uint32_t start;
+    bool     ok;
+    int      failures = 0;
+
+    debounce_init(HALF_ROWS);
+    scan(10);
+
+    /* Clean press and release: reported DEBOUNCE ms after the edge, nothing counted */
+    start = host_timer_ms;
+    set_key(0, 0, true);
+    scan(20);
+    ok = cooked[0] == 0x01 && reported_at - start == DEBOUNCE_MS;
+    start = host_timer_ms;
+    set_key(0, 0, false);
+    scan(20);
+    ok = ok && cooked[0] == 0 && reported_at - start == DEBOUNCE_MS;
+    ok = ok && stats_of(0, 0).bounce == 0 && keytrace_bounce_min_gap() == UINT8_MAX;
+    failures += report("clean edges reported after 5 ms, no bounce", ok);
+
+    /* Press bouncing 3 times, 2 ms apart: 2 bounces, reported 5 ms after the last edge */
+    start = host_timer_ms;
+    bounce(1, 2, 3, 2, true);
+    scan(20);
+    ok = cooked[1] == 0x04 && reported_at - start == 2 * 2 + DEBOUNCE_MS;
+    failures += report("bouncing press counted twice, reported 5 ms after it settles", ok && stats_of(1, 2).bounce == 2);
+    failures += report("shortest bounce gap 2 ms", keytrace_bounce_min_gap() == 2);
+
+    /* Release bouncing 1 ms apart, while another key changes */
+    set_key(2, 5, true);
+    scan(1);
+    bounce(1, 2, 5, 1, false);
+    scan(20);
+    ok = cooked[1] == 0 && cooked[2] == 0x20 && stats_of(1, 2).bounce == 6 && stats_of(2, 5).bounce == 0;
+    failures += report("bouncing release counted 4 more times, other key not counted", ok);
+    failures += report("gap taken from the window opening, 2 ms", keytrace_bounce_min_gap() == 2);
+
+    /* Right half: local row 1 is row 5 of the whole matrix */
+    left = false;
+    bounce(1, 3, 3, 1, true);
+    scan(20);
+    failures += report("right half bounces on row 5", stats_of(5, 3).bounce == 2 && stats_of(1, 3).bounce == 0);
+    failures += report("shortest bounce gap 1 ms", keytrace_bounce_min_gap() == 1);
+
+    /* Saturation */
+    for (int i = 0; i < 10; i++) {
+        bounce(5 - HALF_ROWS, 3, 3, 1, (i & 1) == 0);
+        scan(20);
+    }
+    failures += report("bounce count saturates at 15", stats_of(5, 3).bounce == 15);
+
+    /* Re-press: from the key events, apart from the bounces */
+    event(3, 1, true);
+    scan(50);
+    event(3, 1, false);
+    scan(8);
+    event(3, 1, true);
+    scan(50);
+    event(3, 1, false);
+    ok = stats_of(3, 1).repress == 1 && stats_of(3, 1).bounce == 0 && keytrace_repress_min_gap() == 8;
+    failures += report("re-press within 20 ms counted apart, gap 8 ms", ok);
+
+    return failures != 0;
+}
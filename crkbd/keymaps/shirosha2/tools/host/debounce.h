@@ -0,0 +1,7 @@
+/* Host stand-in, see quantum.h */
+#pragma once
+#include "quantum.h"
+
+void debounce_init(uint8_t num_rows);
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_free(void);
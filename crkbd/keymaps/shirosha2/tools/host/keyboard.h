@@ -0,0 +1,39 @@
+/* Host stand-in for QMK_KEYBOARD_H, for the host tests of the luminous sources (tools/ only) */
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OLED_DRIVER_ENABLE (1)
+#define OLED_BRIGHTNESS 255
+#define OLED_DISPLAY_ADDRESS 0x3C
+#define OLED_MATRIX_SIZE 512
+
+#define QK_USER_0 0x7E40
+#define QK_USER_1 0x7E41
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define memcpy_P memcpy
+
+/* Host clock, advanced by the test */
+extern uint32_t host_timer_ms;
+
+#define TIMER_DIFF_32(a, b) ((uint32_t)((a) - (b)))
+static inline uint32_t timer_read32(void) { return host_timer_ms; }
+
+/* OLED driver, provided by the test */
+typedef struct {
+    uint8_t *current_element;
+    uint16_t remaining_element_count;
+} oled_buffer_reader_t;
+
+oled_buffer_reader_t oled_read_raw(uint16_t start_index);
+void                 oled_write_raw_byte(const char data, uint16_t index);
+uint8_t              oled_set_brightness(uint8_t level);
+uint8_t              oled_get_brightness(void);
+bool                 is_oled_on(void);
+bool                 oled_scroll_set_speed(uint8_t speed);
+bool                 oled_scroll_left(void);
+bool                 oled_scroll_off(void);
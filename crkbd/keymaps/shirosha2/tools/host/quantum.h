@@ -0,0 +1,33 @@
+/* Host stand-in for the QMK headers used by lib/keytrace.c and lib/keytrace_debounce.c (tools/ only) */
+#pragma once
+#include "keyboard.h"
+
+#define MATRIX_ROWS 8 /* both halves */
+#define MATRIX_COLS 6
+#define SPLIT_KEYBOARD
+
+typedef uint8_t matrix_row_t;
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef struct {
+    keypos_t key;
+    bool     pressed;
+    uint16_t time;
+} keyevent_t;
+
+typedef struct {
+    keyevent_t event;
+} keyrecord_t;
+
+#define IS_KEYEVENT(event) true
+
+static inline uint16_t timer_read(void) { return (uint16_t)host_timer_ms; }
+static inline uint16_t timer_elapsed(uint16_t last) { return (uint16_t)(host_timer_ms - last); }
+static inline uint32_t timer_elapsed32(uint32_t last) { return host_timer_ms - last; }
+
+/* Provided by the test */
+bool is_keyboard_left(void);
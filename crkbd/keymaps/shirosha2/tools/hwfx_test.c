@@ -0,0 +1,190 @@
+/********************************************************************************************************************************/
+/*  hwfx_test.c                                                                                                                 */
+/*                                                                                                                              */
+/*  Host test of luminous_hwfx.c against a mock SSD1306 driver and I2C bus.                                                     */
+/*      - Fade   : contrast of every frame on the linear ramp, reached on time, sent only when it changes                       */
+/*      - Shift  : start line commands 1, 2, 3, 2, 1, 0 once per Y_LMHW_SHIFT_PERIOD, paused while the panel is off             */
+/*      - Ticker : scroll held off while the buffer is dirty, then on for the requested time                                    */
+/*                                                                                                                              */
+/*  Build:  cc -std=c11 -Wall -Ihost -I.. '-DQMK_KEYBOARD_H="keyboard.h"' -o hwfx_test hwfx_test.c ../luminous_hwfx.c           */
+/*  Usage:  hwfx_test           (exit status 0 when every check passes)                                                         */
+/*                                                                                                                              */
+/*  The task runs every FRAME_MS, as oled_task does.                                                                            */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "luminous_hwfx.h"
+#include "i2c_master.h"
+
+#define FRAME_MS 50
+#define FADE_MS 512
+#define SHIFT_PERIOD_MS 60000 /* Y_LMHW_SHIFT_PERIOD */
+#define TICKER_MS 2000
+#define LINE_LOG_MAX 16
+
+uint32_t host_timer_ms;
+
+/* Mock panel */
+static uint8_t  contrast = OLED_BRIGHTNESS;
+static unsigned contrast_sets;
+static bool     panel_on = true;
+static bool     buffer_dirty;
+static bool     scrolling;
+static unsigned i2c_transfers;
+static uint8_t  lines[LINE_LOG_MAX]; /* start line commands */
+static uint32_t line_times[LINE_LOG_MAX];
+static unsigned line_count;
+
+uint8_t oled_set_brightness(uint8_t level) {
+    contrast = level;
+    contrast_sets++;
+    return level;
+}
+
+uint8_t oled_get_brightness(void) { return contrast; }
+bool    is_oled_on(void) { return panel_on; }
+bool    oled_scroll_set_speed(uint8_t speed) { return speed <= 7; }
+
+/* As the QMK driver: refused until the dirty buffer is rendered */
+bool oled_scroll_left(void) {
+    if (buffer_dirty) {
+        buffer_dirty = false;
+        return false;
+    }
+    scrolling = true;
+    return true;
+}
+
+bool oled_scroll_off(void) {
+    scrolling = false;
+    return true;
+}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    (void)address;
+    (void)timeout;
+    i2c_transfers++;
+    if (length == 2 && data[0] == 0x00 && (data[1] & 0xC0) == 0x40 && line_count < LINE_LOG_MAX) {
+        line_times[line_count] = host_timer_ms;
+        lines[line_count++]    = data[1] & 0x3F;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+static void frame(void) {
+    host_timer_ms += FRAME_MS;
+    m_lmhw_task();
+}
+
+static int report(const char *name, bool ok) {
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", name);
+    return !ok;
+}
+
+int main(void) {
+    static const uint8_t xuc_shift_lines[] = {1, 2, 3, 2, 1, 0, 1};
+    uint32_t             start;
+    uint32_t             on_time  = 0;
+    uint32_t             off_time = 0;
+    bool                 ok;
+    int                  failures = 0;
+
+    /* Hidden GDDRAM pages cleared at init: the window, then 4 pages x 128 bytes in 16 byte chunks */
+    m_lmhw_init();
+    failures += report("init clears the hidden pages in 33 transfers", i2c_transfers == 1 + 4 * 128 / 16);
+
+    /* Fade out, requested in every frame as luminous_control.c does */
+    start = host_timer_ms;
+    ok    = true;
+    m_lmhw_fade(0, FADE_MS);
+    for (int i = 0; i < 20; i++) {
+        uint32_t t;
+
+        frame();
+        m_lmhw_fade(0, FADE_MS);
+        t  = host_timer_ms - start;
+        ok = ok && contrast == (uint8_t)(OLED_BRIGHTNESS - (OLED_BRIGHTNESS * (t < FADE_MS ? t : FADE_MS)) / FADE_MS);
+    }
+    failures += report("fade out on the linear ramp, 0 after 512 ms", ok && contrast == 0);
+
+    contrast_sets = 0;
+    for (int i = 0; i < 20; i++) {
+        frame();
+        m_lmhw_fade(0, FADE_MS);
+    }
+    failures += report("contrast not sent again once reached", contrast_sets == 0);
+
+    /* Back to full at once, and a fade in from there to the dim level */
+    m_lmhw_fade(OLED_BRIGHTNESS, 0);
+    ok = contrast == OLED_BRIGHTNESS;
+    m_lmhw_fade(16, 1000);
+    for (int i = 0; i < 10; i++) {
+        frame();
+    }
+    ok = ok && contrast == OLED_BRIGHTNESS - ((OLED_BRIGHTNESS - 16) * 500) / 1000;
+    for (int i = 0; i < 10; i++) {
+        frame();
+    }
+    failures += report("immediate fade, then half way at half time", ok && contrast == 16);
+
+    /* Start line shift over 7 periods */
+    start = host_timer_ms;
+    m_lmhw_shift(Y_ON);
+    for (uint32_t t = 0; t < 7 * SHIFT_PERIOD_MS; t += FRAME_MS) {
+        frame();
+    }
+    ok = line_count == sizeof(xuc_shift_lines);
+    for (unsigned i = 0; ok && i < line_count; i++) {
+        ok = lines[i] == xuc_shift_lines[i] && line_times[i] - start == (i + 1) * SHIFT_PERIOD_MS;
+    }
+    failures += report("start line 1, 2, 3, 2, 1, 0, 1 every 60 s", ok);
+
+    /* Paused while the panel is off, put back in place when stopped */
+    panel_on   = false;
+    line_count = 0;
+    for (uint32_t t = 0; t < 3 * SHIFT_PERIOD_MS; t += FRAME_MS) {
+        frame();
+    }
+    ok       = line_count == 0;
+    panel_on = true;
+    m_lmhw_shift(Y_OFF);
+    failures += report("no shift while off, line 0 when stopped", ok && line_count == 1 && lines[0] == 0);
+
+    /* Ticker over a dirty buffer */
+    buffer_dirty = true;
+    start        = host_timer_ms;
+    m_lmhw_ticker(TICKER_MS);
+    ok = m_lmhw_scrolling() == Y_ON;
+    for (int i = 0; i < 60; i++) {
+        frame();
+        if (scrolling && on_time == 0) {
+            on_time = host_timer_ms;
+        }
+        if (!scrolling && on_time != 0 && off_time == 0) {
+            off_time = host_timer_ms;
+        }
+        ok = ok && (m_lmhw_scrolling() == Y_ON) == (off_time == 0);
+    }
+    printf("     scroll on at +%u ms, off at +%u ms\n", (unsigned)(on_time - start), (unsigned)(off_time - start));
+    ok = ok && on_time - start == 2 * FRAME_MS && off_time - on_time >= TICKER_MS && off_time - on_time <= TICKER_MS + FRAME_MS;
+    failures += report("ticker starts once the buffer is sent, scrolls for 2000 ms", ok);
+
+    return failures != 0;
+}
@@ -0,0 +1,62 @@
+#!/bin/sh
+##################################################################################################################################
+#  latency_bench.sh
+#
+#  Key to report latency of the Corne with and without its visual features, on split_sim.cpp.
+#      - Builds the keymap once per variant, with LATENCY_PROBE_PIN on B6
+#      - Runs fixtures/latency_typing.txt and fixtures/latency_idle.txt on each build, timed by the probe pin edges
+#      - Writes the summary and the histogram of each run to <out>/<variant>_<script>.txt, and all summaries to stdout
+#
+#  Usage:  latency_bench.sh [<out>]            (default out: latency; exit status 1 if a variant did not build)
+#      QMK_HOME     qmk_firmware tree with this keymap in keyboards/crkbd/keymaps/shirosha2 (default ~/qmk_firmware)
+#      SPLIT_SIM    split_sim binary (default ./split_sim)
+#
+#  Variants:
+#      all          OLED, RGB and the Labyrinth idle effect
+#      no_effects   OLED and RGB, no idle effect
+#      no_oled      RGB only
+#      no_rgb       OLED and the idle effect, no RGB
+#      none         no OLED, no RGB
+##################################################################################################################################
+
+set -e
+
+TOOLS=$(cd "$(dirname "$0")" && pwd)
+OUT=${1:-latency}
+QMK_HOME=${QMK_HOME:-$HOME/qmk_firmware}
+SPLIT_SIM=${SPLIT_SIM:-./split_sim}
+PROBE="-DLATENCY_PROBE_PIN=B6"
+EFFECTS="-DLMCTL_1501_LABYRINTH_ENABLE=1"
+NO_OLED="-DOLED_DRIVER_ENABLE=0"           # keymap code, see config.h
+OLED_OFF="-e OLED_ENABLE=no"                # driver
+RGB_OFF="-e RGBLIGHT_ENABLE=no -e RGB_MATRIX_ENABLE=no"
+
+STATUS=0
+
+mkdir -p "$OUT"
+
+# bench <variant> <extra flags> [<make variables>...]
+bench() {
+    variant=$1
+    flags=$2
+    shift 2
+    if ! qmk compile -kb crkbd/rev1 -km shirosha2 "$@" -e EXTRAFLAGS="$PROBE $flags" > "$OUT/${variant}_build.log" 2>&1; then
+        printf '%-12s build failed, see %s\n' "$variant" "$OUT/${variant}_build.log"
+        STATUS=1
+        return
+    fi
+    cp "$QMK_HOME/.build/crkbd_rev1_shirosha2.elf" "$OUT/$variant.elf"
+    for script in latency_typing latency_idle; do
+        # Both halves run the same image; VBUS makes the first one the master
+        "$SPLIT_SIM" --probe B6 --histogram 250 "$OUT/$variant.elf" "$OUT/$variant.elf" "$TOOLS/fixtures/$script.txt" \
+            > "$OUT/${variant}_$script.txt" || true
+        printf '%-12s %-16s %s\n' "$variant" "$script" "$(grep '^keys:' "$OUT/${variant}_$script.txt")"
+    done
+}
+
+bench all        "$EFFECTS"
+bench no_effects ""
+bench no_oled    "$EFFECTS $NO_OLED" $OLED_OFF
+bench no_rgb     "$EFFECTS"          $RGB_OFF
+bench none       "$NO_OLED"          $OLED_OFF $RGB_OFF
+exit $STATUS
@@ -0,0 +1,747 @@
+/********************************************************************************************************************************/
+/*  split_sim.cpp                                                                                                               */
+/*                                                                                                                              */
+/*  Two-half split keyboard simulation on simavr.                                                                               */
+/*      - Runs the master and the slave firmware in two ATmega32U4 instances, cycle by cycle                                    */
+/*      - Wires their soft serial pins together (open drain with pull-up), optionally cut for a while                           */
+/*      - Drives both key matrices from a scripted key trace                                                                    */
+/*      - Enumerates the master as a USB host would and captures its reports                                                    */
+/*      - Reports the serial line timing, the key to report latency distribution and the expected reports                       */
+/*                                                                                                                              */
+/*  Build:  g++ -std=c++17 -O2 -Wall -o split_sim split_sim.cpp $(pkg-config --cflags --libs simavr) -lelf                      */
+/*          (simavr with the ATmega32U4 USB block; the firmware is the .elf of a normal build, the same image for both halves)  */
+/*  Usage:  split_sim [--board crkbd | su120] [-t <ms>] [--gap-us <us>] [--deadline-ms <ms>] [--kbd-ep <n>] [--probe <pin>]     */
+/*                    [--histogram <us>] [--seed <n>] [--reports] [-v] <master.elf> <slave.elf> <script>                        */
+/*      --board           matrix and serial pins: crkbd (Corne rev1, default) or su120 (lmkbd/Advanced)                         */
+/*      -t                simulated time [ms] (default: last script line + 500)                                                 */
+/*      --gap-us          idle time that separates two serial bursts (default 100)                                              */
+/*      --deadline-ms     longest key to report latency before an event counts as missed (default 50)                           */
+/*      --kbd-ep          IN endpoint of the keyboard reports (default 1, KEYBOARD_IN_EPNUM without KEYBOARD_SHARED_EP)         */
+/*      --probe           master pin toggled by LATENCY_PROBE_PIN (e.g. B6): time the reports by its edges, to the cycle,       */
+/*                        instead of by the 1 ms USB frame the host read them in                                                */
+/*      --histogram       print the latencies in bins of that width [us] as well                                                */
+/*      --seed            seed of the press phases of the taps lines (default 1)                                                */
+/*      --reports         print only the keyboard reports, as "report <usages>", and the failures: no times, so the output      */
+/*                        of a script can be compared with its expected output                                                  */
+/*      -v                print every USB report and every serial burst                                                         */
+/*  Check:  split_sim --reports crkbd_rev1_shirosha2.elf crkbd_rev1_shirosha2.elf fixtures/split_keys.txt                       */
+/*                    | diff - fixtures/split_keys.expected                                                                     */
+/*  Bench:  latency_bench.sh (builds with and without the OLED, the RGB and the effects, runs fixtures/latency_typing.txt and   */
+/*          fixtures/latency_idle.txt)                                                                                          */
+/*                                                                                                                              */
+/*  Script, one line each, times in simulated [ms], '#' starts a comment:                                                       */
+/*      <ms> master|slave <row> <col> down|up [silent]                                                                          */
+/*                                              press / release a key of that half's own matrix (pin order of --board);         */
+/*                                              silent: the event sends no report by itself (tap-hold and layer keys)           */
+/*      <ms> taps master|slave <row> <col> <count> <period ms>                                                                  */
+/*                                              tap a key count times, each press at a random phase within its first ms         */
+/*                                              (against the scan loop), released half a period later                           */
+/*      <ms> expect [<usage> ...]               the last keyboard report holds exactly these HID usages (hex, E0..E7: mods)     */
+/*      <ms> cut <ms>                           disconnect the serial line for that long                                        */
+/*                                                                                                                              */
+/*  The master is the half with VBUS, as on the real board. Only the reports of the keyboard endpoint count: raw HID and        */
+/*  console traffic neither answer a key event nor change the expected usages. Every key event that is not silent waits for     */
+/*  the next keyboard report and gives one latency figure [us]; the summary gives min / p50 / p90 / p99 / max. Exit status 1    */
+/*  if such an event got no report or an expect line failed.                                                                    */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <avr_ioport.h>
+#include <avr_twi.h>
+#include <avr_usb.h>
+#include <sim_avr.h>
+#include <sim_elf.h>
+
+namespace {
+
+constexpr uint32_t kFrequency   = 16000000;
+constexpr uint32_t kCyclesPerUs = kFrequency / 1000000;
+constexpr uint32_t kCyclesPerMs = kFrequency / 1000;
+constexpr uint8_t  kOledAddr    = 0x3C << 1; /* SSD1306, 8-bit address */
+constexpr uint8_t  kUsbMaxPacket = 64;
+
+struct Pin {
+    char    port; /* 'B'..'F' */
+    uint8_t bit;
+};
+
+struct Board {
+    const char      *name;
+    std::vector<Pin> rows; /* driven low one at a time (COL2ROW) */
+    std::vector<Pin> cols; /* read with pull-ups */
+    Pin              serial;
+};
+
+/* Must match crkbd/info.json and lmkbd/Advanced/config.h */
+const Board kBoards[] = {
+    {"crkbd", {{'D', 4}, {'C', 6}, {'D', 7}, {'E', 6}}, {{'F', 4}, {'F', 5}, {'F', 6}, {'F', 7}, {'B', 1}, {'B', 3}}, {'D', 2}},
+    {"su120",
+     {{'F', 6}, {'F', 7}, {'B', 1}, {'B', 3}, {'B', 2}, {'B', 6}},
+     {{'D', 1}, {'D', 0}, {'D', 4}, {'C', 6}, {'D', 7}, {'E', 6}, {'B', 4}, {'B', 5}, {'F', 4}, {'F', 5}},
+     {'D', 2}},
+};
+
+/* ATmega32U4 data space: PINx, DDRx, PORTx from 0x23 in steps of 3 for ports B..F */
+uint16_t pin_reg(char port) { return static_cast<uint16_t>(0x23 + 3 * (port - 'B')); }
+
+enum class Action { Key, Expect, Cut };
+
+struct Step {
+    uint32_t             ms;
+    uint64_t             cycle  = 0;  /* ms, plus the phase of a taps line */
+    Action               action;
+    bool                 master = false;
+    uint8_t              row    = 0;
+    uint8_t              col    = 0;
+    bool                 down   = false;
+    bool                 silent = false; /* key: no report of its own */
+    uint32_t             length = 0;  /* cut [ms] */
+    std::set<uint8_t>    usages;      /* expect */
+    int                  line   = 0;
+};
+
+struct Options {
+    const Board *board       = &kBoards[0];
+    long         time_ms     = -1;
+    uint32_t     gap_us      = 100;
+    uint32_t     deadline_ms = 50;
+    uint8_t      kbd_ep      = 1;
+    Pin          probe       = {0, 0}; /* port 0: none */
+    uint32_t     histogram_us = 0;
+    uint32_t     seed        = 1;
+    bool         reports     = false;
+    bool         verbose     = false;
+    std::string  master_elf;
+    std::string  slave_elf;
+    std::string  script;
+};
+
+/* One simulated half */
+struct Half {
+    const char                       *name   = "";
+    avr_t                            *avr    = nullptr;
+    std::vector<std::vector<uint8_t>> keys;           /* [row][col] pressed */
+    std::array<uint8_t, 15>           ports  = {};    /* PIN/DDR/PORT B..F at the last wire update */
+    bool                              dirty  = true;  /* keys changed since the last wire update */
+    avr_irq_t                        *twi    = nullptr;
+    uint8_t                           twi_selected = 0;
+    int                               twi_index    = 0;
+    bool                              twi_data     = false;
+    uint32_t                          oled_transfers = 0;
+    uint32_t                          oled_bytes     = 0;
+    uint32_t                          oled_hash      = 2166136261u; /* FNV-1a of the pixel bytes */
+    bool                              usb_attached   = false;
+};
+
+struct Burst {
+    uint64_t start;
+    uint64_t end;
+};
+
+struct Pending {
+    uint64_t cycle;
+    int      line;
+};
+
+/* LATENCY_PROBE_PIN of latency_probe.c: toggled right after each report is written to the endpoint */
+struct Probe {
+    Half                 *half  = nullptr;
+    bool                  level = false;
+    std::vector<uint64_t> edges;
+};
+
+bool driven_low(const Half &h, const Pin &p) {
+    const uint16_t reg  = pin_reg(p.port);
+    const uint8_t  mask = static_cast<uint8_t>(1u << p.bit);
+    return (h.avr->data[reg + 1] & mask) && !(h.avr->data[reg + 2] & mask);
+}
+
+bool is_input(const Half &h, const Pin &p) { return !(h.avr->data[pin_reg(p.port) + 1] & (1u << p.bit)); }
+
+/* Feed a level into an input pin; outputs read back their own drive */
+void drive(Half &h, const Pin &p, bool level) {
+    avr_irq_t *irq = avr_io_getirq(h.avr, AVR_IOCTL_IOPORT_GETIRQ(p.port), p.bit);
+    if (irq && is_input(h, p) && irq->value != static_cast<uint32_t>(level)) {
+        avr_raise_irq(irq, level);
+    }
+}
+
+/* Columns read low where a pressed key joins them to a selected (low) row */
+void update_matrix(Half &h, const Board &b) {
+    std::array<uint8_t, 15> ports;
+    for (int i = 0; i < 15; i++) {
+        ports[i] = h.avr->data[0x23 + i];
+    }
+    if (!h.dirty && ports == h.ports) {
+        return;
+    }
+    h.ports = ports;
+    h.dirty = false;
+    for (std::size_t c = 0; c < b.cols.size(); c++) {
+        bool level = true;
+        for (std::size_t r = 0; r < b.rows.size() && level; r++) {
+            if (h.keys[r][c] && driven_low(h, b.rows[r])) {
+                level = false;
+            }
+        }
+        drive(h, b.cols[c], level);
+    }
+}
+
+/* SSD1306 stand-in: acknowledge everything sent to it, count the pixel bytes */
+void twi_hook(avr_irq_t *irq, uint32_t value, void *param) {
+    (void)irq;
+    Half             &h = *static_cast<Half *>(param);
+    avr_twi_msg_irq_t v;
+    v.u.v = value;
+
+    if (v.u.twi.msg & TWI_COND_STOP) {
+        h.twi_selected = 0;
+    }
+    if (v.u.twi.msg & TWI_COND_START) {
+        h.twi_selected = 0;
+        if ((v.u.twi.addr & 0xFE) == kOledAddr) {
+            h.twi_selected = v.u.twi.addr;
+            h.twi_index    = 0;
+            h.oled_transfers++;
+            avr_raise_irq(h.twi + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, h.twi_selected, 1));
+        }
+    }
+    if (h.twi_selected && (v.u.twi.msg & TWI_COND_WRITE)) {
+        avr_raise_irq(h.twi + TWI_IRQ_INPUT, avr_twi_irq_msg(TWI_COND_ACK, h.twi_selected, 1));
+        if (h.twi_index++ == 0) {
+            h.twi_data = (v.u.twi.data == 0x40); /* control byte: 0x00 commands, 0x40 pixels */
+        } else if (h.twi_data) {
+            h.oled_bytes++;
+            h.oled_hash = (h.oled_hash ^ v.u.twi.data) * 16777619u;
+        }
+    }
+}
+
+void probe_hook(avr_irq_t *irq, uint32_t value, void *param) {
+    (void)irq;
+    Probe &p = *static_cast<Probe *>(param);
+    if ((value != 0) != p.level) {
+        p.level = value != 0;
+        p.edges.push_back(p.half->avr->cycle);
+    }
+}
+
+void usb_attach_hook(avr_irq_t *irq, uint32_t value, void *param) {
+    (void)irq;
+    static_cast<Half *>(param)->usb_attached = value != 0;
+}
+
+bool load_half(Half &h, const char *name, const std::string &elf, const Board &b, bool vbus) {
+    elf_firmware_t fw;
+    std::memset(&fw, 0, sizeof(fw));
+    if (elf_read_firmware(elf.c_str(), &fw) != 0) {
+        std::fprintf(stderr, "split_sim: %s: cannot read\n", elf.c_str());
+        return false;
+    }
+    std::strcpy(fw.mmcu, "atmega32u4");
+    fw.frequency = kFrequency;
+
+    h.name = name;
+    h.avr  = avr_make_mcu_by_name(fw.mmcu);
+    if (!h.avr) {
+        std::fprintf(stderr, "split_sim: simavr has no atmega32u4 core\n");
+        return false;
+    }
+    avr_init(h.avr);
+    avr_load_firmware(h.avr, &fw);
+    h.keys.assign(b.rows.size(), std::vector<uint8_t>(b.cols.size(), 0));
+
+    static const char *twi_names[] = {"twi.out", "twi.in"};
+    h.twi = avr_alloc_irq(&h.avr->irq_pool, 0, 2, twi_names);
+    avr_irq_register_notify(h.twi + TWI_IRQ_OUTPUT, twi_hook, &h);
+    avr_connect_irq(h.twi + TWI_IRQ_INPUT, avr_io_getirq(h.avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+    avr_connect_irq(avr_io_getirq(h.avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), h.twi + TWI_IRQ_OUTPUT);
+
+    if (vbus) {
+        avr_irq_register_notify(avr_io_getirq(h.avr, AVR_IOCTL_USB_GETIRQ(), USB_IRQ_ATTACH), usb_attach_hook, &h);
+        avr_ioctl(h.avr, AVR_IOCTL_USB_VBUS, reinterpret_cast<void *>(1));
+    }
+    return true;
+}
+
+/* Minimal USB host: reset, address, configuration, then poll the IN endpoints once per frame */
+class UsbHost {
+   public:
+    explicit UsbHost(Half &master) : m_(master) {}
+
+    /* Called once per simulated millisecond; returns the reports read in this frame */
+    std::vector<std::pair<uint8_t, std::vector<uint8_t>>> frame() {
+        std::vector<std::pair<uint8_t, std::vector<uint8_t>>> reports;
+        switch (state_) {
+            case State::WaitAttach:
+                if (m_.usb_attached) {
+                    avr_ioctl(m_.avr, AVR_IOCTL_USB_RESET, nullptr);
+                    setup(0x00, 0x05, 1); /* SET_ADDRESS 1 */
+                    state_ = State::Address;
+                }
+                break;
+            case State::Address:
+                if (status()) {
+                    setup(0x00, 0x09, 1); /* SET_CONFIGURATION 1 */
+                    state_ = State::Configure;
+                }
+                break;
+            case State::Configure:
+                if (status()) {
+                    state_ = State::Configured;
+                }
+                break;
+            case State::Configured:
+                for (uint8_t ep = 1; ep < 7; ep++) {
+                    uint8_t     buf[kUsbMaxPacket];
+                    avr_io_usb  pkt{ep, sizeof(buf), buf};
+                    if (avr_ioctl(m_.avr, AVR_IOCTL_USB_READ, &pkt) == 0 && pkt.sz > 0) {
+                        reports.emplace_back(ep, std::vector<uint8_t>(buf, buf + pkt.sz));
+                    }
+                }
+                break;
+        }
+        return reports;
+    }
+
+    bool configured() const { return state_ == State::Configured; }
+
+   private:
+    enum class State { WaitAttach, Address, Configure, Configured };
+
+    struct Setup {
+        uint8_t  type;
+        uint8_t  request;
+        uint16_t value;
+        uint16_t index;
+        uint16_t length;
+    } __attribute__((packed));
+
+    void setup(uint8_t type, uint8_t request, uint16_t value) {
+        Setup      s{type, request, value, 0, 0};
+        avr_io_usb pkt{0, sizeof(s), reinterpret_cast<uint8_t *>(&s)};
+        avr_ioctl(m_.avr, AVR_IOCTL_USB_SETUP, &pkt);
+    }
+
+    /* Status stage of a request without data: a zero length IN */
+    bool status() {
+        avr_io_usb pkt{0, 0, nullptr};
+        return avr_ioctl(m_.avr, AVR_IOCTL_USB_READ, &pkt) == 0;
+    }
+
+    Half &m_;
+    State state_ = State::WaitAttach;
+};
+
+/* Usages of a keyboard report: boot (8 bytes), shared endpoint (report ID 1) or NKRO (report ID 6) */
+bool keyboard_usages(const std::vector<uint8_t> &r, std::set<uint8_t> &usages) {
+    const uint8_t *keys;
+    std::size_t    count;
+    uint8_t        mods;
+    bool           bitmap = false;
+
+    if (r.size() == 8) {
+        mods = r[0], keys = &r[2], count = 6;
+    } else if (r.size() == 9 && r[0] == 1) {
+        mods = r[1], keys = &r[3], count = 6;
+    } else if (r.size() > 2 && r[0] == 6) {
+        mods = r[1], keys = &r[2], count = r.size() - 2, bitmap = true;
+    } else {
+        return false;
+    }
+    usages.clear();
+    for (uint8_t m = 0; m < 8; m++) {
+        if (mods & (1u << m)) {
+            usages.insert(static_cast<uint8_t>(0xE0 + m));
+        }
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        if (bitmap) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (keys[i] & (1u << bit)) {
+                    usages.insert(static_cast<uint8_t>(i * 8 + bit));
+                }
+            }
+        } else if (keys[i]) {
+            usages.insert(keys[i]);
+        }
+    }
+    return true;
+}
+
+std::string usage_list(const std::set<uint8_t> &usages) {
+    std::string s;
+    char        hex[4];
+    for (uint8_t u : usages) {
+        std::snprintf(hex, sizeof(hex), "%02X", u);
+        s += s.empty() ? "" : " ";
+        s += hex;
+    }
+    return s.empty() ? "-" : s;
+}
+
+bool load_script(const std::string &path, const Board &b, uint32_t seed, std::vector<Step> &steps) {
+    std::ifstream in(path);
+    std::string   text;
+    int           line = 0;
+    std::mt19937  rng(seed);
+    std::uniform_int_distribution<uint32_t> phase(0, kCyclesPerMs - 1);
+
+    if (!in) {
+        std::fprintf(stderr, "split_sim: %s: cannot open\n", path.c_str());
+        return false;
+    }
+    while (std::getline(in, text)) {
+        line++;
+        text = text.substr(0, text.find('#'));
+        std::istringstream ss(text);
+        std::string        word;
+        Step               st;
+
+        if (!(ss >> st.ms)) {
+            continue; /* blank or comment */
+        }
+        st.line  = line;
+        st.cycle = static_cast<uint64_t>(st.ms) * kCyclesPerMs;
+        ss >> word;
+        if (word == "taps") {
+            std::string half;
+            unsigned    row, col, count, period;
+            if (!(ss >> half >> row >> col >> count >> period) || (half != "master" && half != "slave") || row >= b.rows.size() ||
+                col >= b.cols.size() || period < 2) {
+                std::fprintf(stderr, "split_sim: %s:%d: bad taps line\n", path.c_str(), line);
+                return false;
+            }
+            for (unsigned i = 0; i < count; i++) {
+                Step tap   = st;
+                tap.action = Action::Key;
+                tap.master = half == "master";
+                tap.row    = static_cast<uint8_t>(row);
+                tap.col    = static_cast<uint8_t>(col);
+                tap.ms     = st.ms + i * period;
+                tap.cycle  = static_cast<uint64_t>(tap.ms) * kCyclesPerMs + phase(rng); /* any phase of the scan */
+                tap.down   = true;
+                steps.push_back(tap);
+                tap.ms += period / 2;
+                tap.cycle += static_cast<uint64_t>(period / 2) * kCyclesPerMs;
+                tap.down = false;
+                steps.push_back(tap);
+            }
+            continue;
+        }
+        if (word == "master" || word == "slave") {
+            unsigned    row, col;
+            std::string edge, flag;
+            st.action = Action::Key;
+            st.master = word == "master";
+            if (!(ss >> row >> col >> edge) || row >= b.rows.size() || col >= b.cols.size() || (edge != "down" && edge != "up") ||
+                ((ss >> flag) && flag != "silent")) {
+                std::fprintf(stderr, "split_sim: %s:%d: bad key line\n", path.c_str(), line);
+                return false;
+            }
+            st.row    = static_cast<uint8_t>(row);
+            st.col    = static_cast<uint8_t>(col);
+            st.down   = edge == "down";
+            st.silent = flag == "silent";
+        } else if (word == "expect") {
+            st.action = Action::Expect;
+            while (ss >> word) {
+                st.usages.insert(static_cast<uint8_t>(std::strtoul(word.c_str(), nullptr, 16)));
+            }
+        } else if (word == "cut" && (ss >> st.length)) {
+            st.action = Action::Cut;
+        } else {
+            std::fprintf(stderr, "split_sim: %s:%d: unknown line\n", path.c_str(), line);
+            return false;
+        }
+        steps.push_back(st);
+    }
+    std::stable_sort(steps.begin(), steps.end(), [](const Step &a, const Step &b) { return a.cycle < b.cycle; });
+    return true;
+}
+
+void usage() {
+    std::fprintf(stderr, "usage: split_sim [--board crkbd | su120] [-t <ms>] [--gap-us <us>] [--deadline-ms <ms>] [--kbd-ep <n>] "
+                         "[--probe <pin>] [--histogram <us>] [--seed <n>] [--reports] [-v] <master.elf> <slave.elf> <script>\n");
+}
+
+bool parse_args(int argc, char **argv, Options &opt) {
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--board" && i + 1 < argc) {
+            std::string name = argv[++i];
+            auto it = std::find_if(std::begin(kBoards), std::end(kBoards), [&](const Board &b) { return name == b.name; });
+            if (it == std::end(kBoards)) {
+                return false;
+            }
+            opt.board = &*it;
+        } else if (arg == "-t" && i + 1 < argc) {
+            opt.time_ms = std::atol(argv[++i]);
+        } else if (arg == "--gap-us" && i + 1 < argc) {
+            opt.gap_us = static_cast<uint32_t>(std::atol(argv[++i]));
+        } else if (arg == "--deadline-ms" && i + 1 < argc) {
+            opt.deadline_ms = static_cast<uint32_t>(std::atol(argv[++i]));
+        } else if (arg == "--kbd-ep" && i + 1 < argc) {
+            opt.kbd_ep = static_cast<uint8_t>(std::atoi(argv[++i]));
+        } else if (arg == "--probe" && i + 1 < argc) {
+            std::string pin = argv[++i];
+            if (pin.size() != 2 || pin[0] < 'B' || pin[0] > 'F' || pin[1] < '0' || pin[1] > '7') {
+                return false;
+            }
+            opt.probe = {pin[0], static_cast<uint8_t>(pin[1] - '0')};
+        } else if (arg == "--histogram" && i + 1 < argc) {
+            opt.histogram_us = static_cast<uint32_t>(std::atol(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            opt.seed = static_cast<uint32_t>(std::atol(argv[++i]));
+        } else if (arg == "--reports") {
+            opt.reports = true;
+        } else if (arg == "-v") {
+            opt.verbose = true;
+        } else if (!arg.empty() && arg[0] != '-') {
+            files.push_back(arg);
+        } else {
+            return false;
+        }
+    }
+    if (files.size() != 3 || opt.kbd_ep == 0 || opt.kbd_ep >= 7) {
+        return false;
+    }
+    opt.master_elf = files[0];
+    opt.slave_elf  = files[1];
+    opt.script     = files[2];
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options           opt;
+    std::vector<Step> steps;
+
+    if (!parse_args(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    if (!load_script(opt.script, *opt.board, opt.seed, steps)) {
+        return 2;
+    }
+    if (opt.time_ms < 0) {
+        opt.time_ms = (steps.empty() ? 0 : steps.back().ms) + 500;
+    }
+
+    const Board &b = *opt.board;
+    Half         master, slave;
+    if (!load_half(master, "master", opt.master_elf, b, true) || !load_half(slave, "slave", opt.slave_elf, b, false)) {
+        return 1;
+    }
+    UsbHost host(master);
+    Probe   probe;
+    if (opt.probe.port) {
+        probe.half = &master;
+        avr_irq_register_notify(avr_io_getirq(master.avr, AVR_IOCTL_IOPORT_GETIRQ(opt.probe.port), opt.probe.bit), probe_hook, &probe);
+    }
+
+    const uint64_t     end_cycle = static_cast<uint64_t>(opt.time_ms) * kCyclesPerMs;
+    const uint64_t     gap       = static_cast<uint64_t>(opt.gap_us) * kCyclesPerUs;
+    std::size_t        next_step = 0;
+    uint64_t           next_frame = kCyclesPerMs;
+    uint64_t           cut_until  = 0;
+    bool               line_high  = true;
+    uint64_t           line_edge  = 0; /* cycle of the last edge */
+    bool               in_burst   = false;
+    Burst              burst{0, 0};
+    std::vector<Burst> bursts;
+    std::deque<Pending> pending;
+    std::vector<uint32_t> latencies;
+    std::set<uint8_t>  current; /* usages of the last keyboard report */
+    std::vector<uint8_t> last_report[8];
+    int                failures = 0, missed = 0;
+
+    for (;;) {
+        Half          &h   = (master.avr->cycle <= slave.avr->cycle) ? master : slave;
+        const uint64_t now = std::min(master.avr->cycle, slave.avr->cycle);
+        const uint32_t ms  = static_cast<uint32_t>(now / kCyclesPerMs);
+
+        if (now >= end_cycle) {
+            break;
+        }
+        const int state = avr_run(h.avr);
+        if (state == cpu_Done || state == cpu_Crashed) {
+            std::fprintf(stderr, "split_sim: %s stopped at %u ms (%s)\n", h.name, ms, state == cpu_Crashed ? "crashed" : "done");
+            return 1;
+        }
+
+        /* Script */
+        while (next_step < steps.size() && steps[next_step].cycle <= now) {
+            const Step &st = steps[next_step++];
+            if (st.action == Action::Key) {
+                Half &k            = st.master ? master : slave;
+                k.keys[st.row][st.col] = st.down;
+                k.dirty            = true;
+                if (!st.silent) {
+                    pending.push_back({now, st.line});
+                }
+            } else if (st.action == Action::Cut) {
+                cut_until = now + static_cast<uint64_t>(st.length) * kCyclesPerMs;
+            } else if (current != st.usages) {
+                std::printf("%6u ms  FAIL line %d: expected %s, report has %s\n", ms, st.line, usage_list(st.usages).c_str(),
+                            usage_list(current).c_str());
+                failures++;
+            }
+        }
+
+        /* Wires: matrices, then the serial line (wired AND, each side alone while cut) */
+        update_matrix(master, b);
+        update_matrix(slave, b);
+        const bool cut        = now < cut_until;
+        const bool master_low = driven_low(master, b.serial);
+        const bool slave_low  = driven_low(slave, b.serial);
+        drive(master, b.serial, !(master_low || (!cut && slave_low)));
+        drive(slave, b.serial, !(slave_low || (!cut && master_low)));
+
+        const bool high = !(master_low || slave_low) || cut;
+        if (high != line_high) {
+            if (!high && !in_burst) {
+                in_burst    = true;
+                burst.start = now;
+            }
+            line_high = high;
+            line_edge = now;
+        } else if (in_burst && high && now - line_edge >= gap) {
+            in_burst  = false;
+            burst.end = line_edge;
+            bursts.push_back(burst);
+            if (opt.verbose) {
+                std::printf("%6u ms  serial %llu us\n", ms, static_cast<unsigned long long>((burst.end - burst.start) / kCyclesPerUs));
+            }
+        }
+
+        /* USB frame */
+        if (master.avr->cycle >= next_frame) {
+            next_frame += kCyclesPerMs;
+            for (auto &report : host.frame()) {
+                const uint8_t ep = report.first;
+                if (ep >= 8 || report.second == last_report[ep]) {
+                    continue;
+                }
+                last_report[ep] = report.second;
+                if (opt.verbose) {
+                    std::printf("%6u ms  ep%u ", ms, ep);
+                    for (uint8_t byte : report.second) {
+                        std::printf(" %02X", byte);
+                    }
+                    std::printf("\n");
+                }
+                std::set<uint8_t> usages;
+                if (ep != opt.kbd_ep || !keyboard_usages(report.second, usages)) {
+                    continue; /* raw HID, console, ... */
+                }
+                current = usages;
+                if (opt.reports) {
+                    std::printf("report %s\n", usage_list(current).c_str());
+                }
+                if (!opt.probe.port && !pending.empty()) {
+                    latencies.push_back(static_cast<uint32_t>((master.avr->cycle - pending.front().cycle) / kCyclesPerUs));
+                    pending.pop_front();
+                }
+            }
+        }
+        for (uint64_t edge : probe.edges) {
+            if (!pending.empty() && edge >= pending.front().cycle) {
+                latencies.push_back(static_cast<uint32_t>((edge - pending.front().cycle) / kCyclesPerUs));
+                pending.pop_front();
+            }
+        }
+        probe.edges.clear();
+        while (!pending.empty() && now - pending.front().cycle > static_cast<uint64_t>(opt.deadline_ms) * kCyclesPerMs) {
+            std::printf("%6u ms  FAIL line %d: no report within %u ms\n", ms, pending.front().line, opt.deadline_ms);
+            pending.pop_front();
+            missed++;
+        }
+    }
+
+    if (opt.reports) {
+        if (!host.configured()) {
+            std::printf("FAIL usb not configured\n");
+            failures++;
+        }
+        return (failures + missed) ? 1 : 0;
+    }
+    std::printf("usb: %s\n", host.configured() ? "configured" : "not configured");
+    if (bursts.empty()) {
+        std::printf("serial: no activity\n");
+        failures++;
+    } else {
+        uint64_t shortest = UINT64_MAX, longest = 0, total = 0, max_gap = 0;
+        for (std::size_t i = 0; i < bursts.size(); i++) {
+            const uint64_t len = bursts[i].end - bursts[i].start;
+            shortest           = std::min(shortest, len);
+            longest            = std::max(longest, len);
+            total += len;
+            if (i > 0) {
+                max_gap = std::max(max_gap, bursts[i].start - bursts[i - 1].end);
+            }
+        }
+        std::printf("serial: %zu bursts, %llu / %llu / %llu us (min / avg / max), busy %.1f %%, longest pause %llu us\n", bursts.size(),
+                    static_cast<unsigned long long>(shortest / kCyclesPerUs),
+                    static_cast<unsigned long long>(total / bursts.size() / kCyclesPerUs),
+                    static_cast<unsigned long long>(longest / kCyclesPerUs), 100.0 * static_cast<double>(total) / static_cast<double>(end_cycle),
+                    static_cast<unsigned long long>(max_gap / kCyclesPerUs));
+    }
+    if (!latencies.empty()) {
+        const std::size_t n   = latencies.size();
+        auto              pct = [&](std::size_t p) { return latencies[std::min(n - 1, n * p / 100)]; };
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("keys: %zu reported, latency %u / %u / %u / %u / %u us (min / p50 / p90 / p99 / max, %s), %d missed\n", n,
+                    latencies.front(), pct(50), pct(90), pct(99), latencies.back(), opt.probe.port ? "probe pin" : "USB frames", missed);
+        if (opt.histogram_us) {
+            std::size_t at = 0;
+            for (uint32_t from = latencies.front() / opt.histogram_us * opt.histogram_us; at < n; from += opt.histogram_us) {
+                const std::size_t start = at;
+                while (at < n && latencies[at] < from + opt.histogram_us) {
+                    at++;
+                }
+                std::printf("latency %6u us %6zu\n", from, at - start);
+            }
+        }
+    } else {
+        std::printf("keys: none reported, %d missed\n", missed);
+    }
+    for (const Half *h : {&master, &slave}) {
+        std::printf("oled %-6s: %u transfers, %u pixel bytes, hash %08X\n", h->name, h->oled_transfers, h->oled_bytes, h->oled_hash);
+    }
+    return (failures + missed) ? 1 : 0;
+}
@@ -0,0 +1,378 @@
+/********************************************************************************************************************************/
+/*  tlm_monitor.cpp                                                                                                             */
+/*                                                                                                                              */
+/*  Host side of the raw HID telemetry (telemetry.c).                                                                           */
+/*      - Polls snapshot frames and prints rates                                                                                */
+/*      - Pulls the key event trace, or the per-key statistics (lib/keytrace.h)                                                 */
+/*      - Reads the slave half frames and the split transaction timing (split_sync.c)                                           */
+/*                                                                                                                              */
+/*  Build:  g++ -std=c++17 -O2 -Wall -o tlm_monitor tlm_monitor.cpp                                                             */
+/*  Usage:  tlm_monitor [-i <ms>] [-n <count>] [--no-report-id] [--replay | --slave | --trace | --stats | --split] <device>    */
+/*      <device>          /dev/hidrawN of the raw HID interface (usage page 0xFF60), or a stand-in:                             */
+/*      --no-report-id    do not prefix the requests with report ID 0 (pty stand-in answering like the firmware)                */
+/*      --replay          only read frames back to back, send no requests (file of concatenated 32-byte frames)                 */
+/*      --slave           same rates for the slave half (its frame is refreshed about once a second, while no key is used)      */
+/*      --trace           print the key events as "<time [ms]> <row> <col> down|up", one per line, until interrupted            */
+/*      --stats           print presses, average hold, average interval from the previous press, bounces inside the debounce    */
+/*                        window and re-presses after it, of every pressed key                                                  */
+/*      --split           print the count, failures, last and longest duration of the scheduled split transactions              */
+/*                        and the link losses, recoveries, last and longest outage                                              */
+/*  Check:  tlm_monitor --replay fixtures/tlm_replay.bin | diff - fixtures/tlm_replay.txt                                       */
+/*          (4 snapshot frames, 1 s apart, the third one with the split link down)                                              */
+/********************************************************************************************************************************/
+
+/*
+Copyright 2024 ryhoh/shirosha2
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+/* Must match telemetry.h */
+constexpr std::size_t kFrameSize     = 32;
+constexpr uint8_t     kCmdSnapshot   = 0x01;
+constexpr uint8_t     kCmdTrace      = 0x02;
+constexpr uint8_t     kCmdKeyStats   = 0x03;
+constexpr uint8_t     kCmdSlave      = 0x04;
+constexpr uint8_t     kCmdSplit      = 0x05;
+constexpr std::size_t kSplitHeader   = 4;
+constexpr std::size_t kSplitStatSize = 8;
+constexpr std::size_t kSplitLinkSize = 8;
+constexpr std::size_t kTraceHeader   = 4;
+constexpr uint8_t     kMatrixMax     = 16; /* row and column are one nibble each in the trace */
+constexpr uint8_t     kVersion       = 1;
+constexpr uint8_t     kFlagMaster    = 0x01;
+constexpr uint8_t     kFlagSplitLink = 0x02;
+constexpr int         kReadTimeoutMs = 1000;
+
+using Frame = std::array<uint8_t, kFrameSize>;
+
+struct Snapshot {
+    uint8_t  flags;
+    uint32_t uptime_ms;
+    uint32_t scans;
+    uint32_t key_events;
+    uint32_t oled_calls;
+    uint32_t oled_time_us;
+    uint16_t oled_max_us;
+    uint16_t loop_max_us;
+    uint16_t split_drops;
+};
+
+struct Options {
+    int         interval_ms = 1000;
+    long        count       = -1; /* forever */
+    bool        report_id   = true;
+    bool        replay      = false;
+    bool        trace       = false;
+    bool        stats       = false;
+    bool        slave       = false;
+    bool        split       = false;
+    std::string device;
+};
+
+uint16_t le16(const Frame &f, std::size_t at) { return static_cast<uint16_t>(f[at] | (f[at + 1] << 8)); }
+
+uint32_t le32(const Frame &f, std::size_t at) {
+    return static_cast<uint32_t>(f[at]) | (static_cast<uint32_t>(f[at + 1]) << 8) | (static_cast<uint32_t>(f[at + 2]) << 16) |
+           (static_cast<uint32_t>(f[at + 3]) << 24);
+}
+
+std::optional<Snapshot> parse(const Frame &f) {
+    if ((f[0] != kCmdSnapshot && f[0] != kCmdSlave) || f[1] != kVersion) {
+        return std::nullopt;
+    }
+    Snapshot s;
+    s.flags        = f[2];
+    s.uptime_ms    = le32(f, 4);
+    s.scans        = le32(f, 8);
+    s.key_events   = le32(f, 12);
+    s.oled_calls   = le32(f, 16);
+    s.oled_time_us = le32(f, 20);
+    s.oled_max_us  = le16(f, 24);
+    s.loop_max_us  = le16(f, 26);
+    s.split_drops  = le16(f, 28);
+    return s;
+}
+
+bool send_request(int fd, bool report_id, uint8_t command, uint8_t arg1 = 0, uint8_t arg2 = 0) {
+    uint8_t     report[kFrameSize + 1] = {0};
+    uint8_t    *payload                = report_id ? report + 1 : report;
+    std::size_t length                 = report_id ? sizeof(report) : kFrameSize;
+
+    payload[0] = command;
+    payload[1] = arg1;
+    payload[2] = arg2;
+    return write(fd, report, length) == static_cast<ssize_t>(length);
+}
+
+/* Read one frame; hidraw returns whole reports, a pty or a file may split them */
+bool read_frame(int fd, Frame &frame, bool wait) {
+    std::size_t got = 0;
+
+    while (got < kFrameSize) {
+        if (wait) {
+            pollfd pfd{fd, POLLIN, 0};
+            int    ready = poll(&pfd, 1, kReadTimeoutMs);
+            if (ready <= 0) {
+                std::fprintf(stderr, "tlm_monitor: %s\n", ready == 0 ? "no answer" : std::strerror(errno));
+                return false;
+            }
+        }
+        ssize_t n = read(fd, frame.data() + got, kFrameSize - got);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        got += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+void print_rates(const Snapshot &prev, const Snapshot &now) {
+    const uint32_t dt_ms = now.uptime_ms - prev.uptime_ms;
+    if (dt_ms == 0) {
+        return;
+    }
+    const double   dt_s       = dt_ms / 1000.0;
+    const uint32_t oled_calls = now.oled_calls - prev.oled_calls;
+    const uint32_t oled_us    = now.oled_time_us - prev.oled_time_us;
+
+    std::printf("%10.3fs  scan %7.0f/s  keys %5.1f/s  oled %4.1f/s avg %5.0fus max %5uus cpu %4.1f%%  loop max %5uus  drops %u%s\n",
+                now.uptime_ms / 1000.0, (now.scans - prev.scans) / dt_s, (now.key_events - prev.key_events) / dt_s, oled_calls / dt_s,
+                oled_calls ? static_cast<double>(oled_us) / oled_calls : 0.0, now.oled_max_us, oled_us / (dt_ms * 10.0), now.loop_max_us,
+                static_cast<unsigned>(static_cast<uint16_t>(now.split_drops - prev.split_drops)),
+                (now.flags & kFlagMaster) && !(now.flags & kFlagSplitLink) ? "  [split link down]" : "");
+    std::fflush(stdout);
+}
+
+/* Decode the records of one trace response; time runs on across responses */
+void print_trace(const Frame &f, uint32_t &time_ms, uint16_t &dropped) {
+    const std::size_t end  = kTraceHeader + std::min<std::size_t>(f[1], kFrameSize - kTraceHeader);
+    const uint16_t    lost = le16(f, 2);
+
+    if (lost != dropped) {
+        std::printf("# %u records lost, times below are relative\n", static_cast<unsigned>(static_cast<uint16_t>(lost - dropped)));
+        dropped = lost;
+    }
+    for (std::size_t at = kTraceHeader; at < end;) {
+        uint32_t value = 0;
+        unsigned shift = 0;
+        while (at < end && (f[at] & 0x80)) {
+            value |= static_cast<uint32_t>(f[at++] & 0x7F) << shift;
+            shift += 7;
+        }
+        if (at + 1 >= end) {
+            std::fprintf(stderr, "tlm_monitor: truncated trace record\n");
+            return;
+        }
+        value |= static_cast<uint32_t>(f[at++]) << shift;
+        const uint8_t key = f[at++];
+
+        time_ms += value >> 1;
+        std::printf("%10u %2u %2u %s\n", time_ms, key >> 4, key & 0x0F, (value & 1) ? "down" : "up");
+    }
+    std::fflush(stdout);
+}
+
+int run_trace(int fd, const Options &opt) {
+    uint32_t time_ms = 0;
+    uint16_t dropped = 0;
+
+    for (long polled = 0; opt.count < 0 || polled < opt.count; polled++) {
+        Frame frame;
+        do {
+            if (!send_request(fd, opt.report_id, kCmdTrace) || !read_frame(fd, frame, true)) {
+                return 1;
+            }
+            if (frame[0] != kCmdTrace) {
+                std::fprintf(stderr, "tlm_monitor: no key trace (command 0x%02X), build with KEYTRACE_ENABLE\n", frame[0]);
+                return 1;
+            }
+            print_trace(frame, time_ms, dropped);
+        } while (frame[1] != 0); /* drain, then wait */
+        std::this_thread::sleep_for(std::chrono::milliseconds(opt.interval_ms));
+    }
+    return 0;
+}
+
+int run_stats(int fd, const Options &opt) {
+    uint8_t bounce_gap  = 0xFF;
+    uint8_t repress_gap = 0xFF;
+
+    std::printf("row col presses hold[ms] interval[ms] bounce repress\n");
+    for (uint8_t row = 0; row < kMatrixMax; row++) {
+        for (uint8_t col = 0; col < kMatrixMax; col++) {
+            Frame frame;
+            if (!send_request(fd, opt.report_id, kCmdKeyStats, row, col) || !read_frame(fd, frame, true)) {
+                return 1;
+            }
+            if (frame[0] != kCmdKeyStats) {
+                if (col == 0) {
+                    if (bounce_gap != 0xFF) {
+                        std::printf("shortest bounce gap %u ms (raw changes inside the debounce window)\n", bounce_gap);
+                    }
+                    if (repress_gap != 0xFF) {
+                        std::printf("shortest re-press gap %u ms (re-presses after debounce)\n", repress_gap);
+                    }
+                    return row == 0 ? 1 : 0; /* past the last row */
+                }
+                break; /* past the last column */
+            }
+            if (le16(frame, 3) != 0) {
+                std::printf("%3u %3u %7u %8u %12u %6u %7u\n", row, col, le16(frame, 3), le16(frame, 5), le16(frame, 7), frame[9],
+                            frame[11]);
+            }
+            bounce_gap  = std::min(bounce_gap, frame[10]);
+            repress_gap = std::min(repress_gap, frame[12]);
+        }
+    }
+    return 0;
+}
+
+int run_split(int fd, const Options &opt) {
+    static const char *const kNames[] = {"state", "telemetry"};
+    Frame                    frame;
+
+    if (!send_request(fd, opt.report_id, kCmdSplit) || !read_frame(fd, frame, true)) {
+        return 1;
+    }
+    if (frame[0] != kCmdSplit) {
+        std::fprintf(stderr, "tlm_monitor: no split statistics (command 0x%02X)\n", frame[0]);
+        return 1;
+    }
+    std::printf("transaction  count  fails  last[us]  max[us]\n");
+    for (uint8_t id = 0; id < frame[1] && kSplitHeader + (id + 1) * kSplitStatSize <= kFrameSize; id++) {
+        const std::size_t at = kSplitHeader + id * kSplitStatSize;
+        std::printf("%-11s %6u %6u %9u %8u\n", id < 2 ? kNames[id] : "?", le16(frame, at), le16(frame, at + 2), le16(frame, at + 4),
+                    le16(frame, at + 6));
+    }
+    const std::size_t link = kSplitHeader + frame[1] * kSplitStatSize;
+    if (link + kSplitLinkSize <= kFrameSize) {
+        std::printf("link lost %u, recovered %u, last outage %u ms, longest %u ms\n", le16(frame, link), le16(frame, link + 2),
+                    le16(frame, link + 4), le16(frame, link + 6));
+    }
+    return 0;
+}
+
+void usage() {
+    std::fprintf(stderr, "usage: tlm_monitor [-i <ms>] [-n <count>] [--no-report-id] [--replay | --slave | --trace | --stats | --split] <device>\n");
+}
+
+bool parse_args(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-i" && i + 1 < argc) {
+            opt.interval_ms = std::atoi(argv[++i]);
+        } else if (arg == "-n" && i + 1 < argc) {
+            opt.count = std::atol(argv[++i]);
+        } else if (arg == "--no-report-id") {
+            opt.report_id = false;
+        } else if (arg == "--replay") {
+            opt.replay = true;
+        } else if (arg == "--trace") {
+            opt.trace = true;
+        } else if (arg == "--stats") {
+            opt.stats = true;
+        } else if (arg == "--slave") {
+            opt.slave = true;
+        } else if (arg == "--split") {
+            opt.split = true;
+        } else if (!arg.empty() && arg[0] != '-' && opt.device.empty()) {
+            opt.device = arg;
+        } else {
+            return false;
+        }
+    }
+    return !opt.device.empty() && opt.interval_ms >= 0 && (opt.replay + opt.trace + opt.stats + opt.slave + opt.split) <= 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    int fd = open(opt.device.c_str(), opt.replay ? O_RDONLY : O_RDWR);
+    if (fd < 0) {
+        std::fprintf(stderr, "tlm_monitor: %s: %s\n", opt.device.c_str(), std::strerror(errno));
+        return 1;
+    }
+    if (isatty(fd)) {
+        termios tio;
+        if (tcgetattr(fd, &tio) == 0) {
+            cfmakeraw(&tio); /* pass the binary frames untouched */
+            tcsetattr(fd, TCSANOW, &tio);
+        }
+    }
+
+    if (opt.trace || opt.stats || opt.split) {
+        int status = opt.trace ? run_trace(fd, opt) : opt.stats ? run_stats(fd, opt) : run_split(fd, opt);
+        close(fd);
+        return status;
+    }
+
+    std::optional<Snapshot> prev;
+    for (long polled = 0; opt.count < 0 || polled <= opt.count; polled++) {
+        Frame frame;
+
+        if (!opt.replay && !send_request(fd, opt.report_id, opt.slave ? kCmdSlave : kCmdSnapshot)) {
+            std::fprintf(stderr, "tlm_monitor: write: %s\n", std::strerror(errno));
+            return 1;
+        }
+        if (!read_frame(fd, frame, !opt.replay)) {
+            break; /* end of the replay, or no answer */
+        }
+
+        std::optional<Snapshot> now = parse(frame);
+        if (now) {
+            if (prev) {
+                print_rates(*prev, *now);
+            }
+            prev = now;
+        } else if (!(opt.slave && frame[0] == kCmdSlave)) { /* else nothing pulled from the slave yet */
+            std::fprintf(stderr, "tlm_monitor: unexpected frame (command 0x%02X, version %u)\n", frame[0], frame[1]);
+        }
+
+        if (!opt.replay) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(opt.interval_ms));
+        }
+    }
+
+    close(fd);
+    return prev ? 0 : 1;
+}
@@ -1,3 +1,4 @@
 MOUSEKEY_ENABLE = no     # Mouse keys
 VIA_ENABLE      = yes    # Enable VIA
 LTO_ENABLE      = yes
+SRC += ./lib/dynamic_keymap_cache.c
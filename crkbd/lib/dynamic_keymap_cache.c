@@ -0,0 +1,93 @@
+#include "quantum.h"
+#include "keymap_introspection.h"
+#include "via.h"
+
+// RAM cache of the keycode each key resolves to for the current layer state.
+//
+// With VIA every keymap_key_to_keycode() call is an EEPROM read, and a key
+// event walks the layer stack from the top, so one event may cost several
+// reads. The cache keeps, per matrix position, the layer the key resolves to
+// and its keycode. It is dropped as a whole when the active layers change and
+// per key when VIA writes that key, then refilled on the next lookup.
+
+#ifdef ENCODER_MAP_ENABLE
+#    error "dynamic_keymap_cache.c does not handle encoder map positions"
+#endif
+
+static uint16_t      cache_keycode[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       cache_layer[MATRIX_ROWS][MATRIX_COLS];
+static matrix_row_t  cache_valid[MATRIX_ROWS];
+static layer_state_t cache_layers;
+
+static void cache_invalidate(void) {
+    memset(cache_valid, 0, sizeof(cache_valid));
+}
+
+// Same walk as layer_switch_get_layer(): highest active non-transparent layer, else layer 0
+static void cache_fill(uint8_t row, uint8_t col, layer_state_t layers) {
+    uint8_t  layer   = 0;
+    uint16_t keycode = KC_TRNS;
+
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            keycode = keycode_at_keymap_location(i, row, col);
+            if (keycode != KC_TRNS) {
+                layer = i;
+                break;
+            }
+        }
+    }
+    if (keycode == KC_TRNS) {
+        keycode = keycode_at_keymap_location(0, row, col);
+    }
+
+    cache_layer[row][col]   = layer;
+    cache_keycode[row][col] = keycode;
+    cache_valid[row] |= (matrix_row_t)1 << col;
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return KC_NO;
+    }
+
+    const layer_state_t layers = layer_state | default_layer_state;
+
+    if (layers != cache_layers) {
+        cache_layers = layers;
+        cache_invalidate();
+    }
+    if (!(cache_valid[key.row] & ((matrix_row_t)1 << key.col))) {
+        cache_fill(key.row, key.col, layers);
+    }
+
+    const uint8_t resolved = cache_layer[key.row][key.col];
+
+    if (layer == resolved) {
+        return cache_keycode[key.row][key.col];
+    }
+    // Active layers above the resolved one are transparent for this key
+    if (layer > resolved && (layers & ((layer_state_t)1 << layer))) {
+        return KC_TRNS;
+    }
+    // Inactive layer, e.g. the source layer of a key released after a layer change
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+
+// Runs before VIA handles the command, and the keymap is only read again
+// after the write completes.
+bool via_command_kb(uint8_t *data, uint8_t length) {
+    switch (data[0]) {
+        case id_dynamic_keymap_set_keycode:
+            // data: command, layer, row, col, keycode (big endian)
+            if (data[2] < MATRIX_ROWS && data[3] < MATRIX_COLS) {
+                cache_valid[data[2]] &= ~((matrix_row_t)1 << data[3]);
+            }
+            break;
+        case id_dynamic_keymap_reset:
+        case id_dynamic_keymap_set_buffer:
+            cache_invalidate();
+            break;
+    }
+    return false;
+}
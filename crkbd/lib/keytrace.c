@@ -0,0 +1,216 @@
+#include "quantum.h"
+#include "keytrace.h"
+
+// Ring buffer of varint coded key events, plus per-key moving averages of the
+// hold time and of the interval from the previous press.
+//
+// When the buffer is full the oldest records are dropped, so a reader that
+// falls behind loses the start of the trace and keytrace_dropped() says how
+// much. The per-key statistics keep counting regardless.
+//
+// Chatter is counted twice. The bounces inside the debounce window come from
+// the raw matrix (keytrace_debounce.c, keytrace_bounce()); they tell whether
+// DEBOUNCE could be lower. A press that follows the release of the same key
+// within KEYTRACE_REPRESS_MS got through debounce as a double press; that
+// re-press count is seen at the event level here. The counts are 4-bit, two
+// keys per byte.
+
+#if KEYTRACE_BUFFER_SIZE > 255
+#    error "keytrace.c: KEYTRACE_BUFFER_SIZE must fit the 8-bit ring indices (<= 255)"
+#endif
+#if MATRIX_ROWS > 16 || MATRIX_COLS > 16
+#    error "keytrace.c: row and column are packed in one nibble each"
+#endif
+#if KEYTRACE_REPRESS_MS > 255
+#    error "keytrace.c: KEYTRACE_REPRESS_MS must fit the 8-bit gap (<= 255)"
+#endif
+
+#define KEYTRACE_RECORD_MAX 4 // 3 varint bytes for 17 bits, 1 key byte
+#define KEYTRACE_EMA_SHIFT 3  // moving averages weigh the new sample 1/8
+
+#define KEYTRACE_KEYS (MATRIX_ROWS * MATRIX_COLS)
+
+typedef struct {
+    uint16_t edge_time; // last press, then last release
+    uint16_t presses;
+    uint16_t hold_ms;
+    uint16_t interval_ms;
+} keytrace_key_t;
+
+static uint8_t        buffer[KEYTRACE_BUFFER_SIZE];
+static uint8_t        head; // next byte written
+static uint8_t        tail; // oldest byte
+static uint8_t        used;
+static uint16_t       dropped;
+static uint16_t       last_time;
+static uint32_t       last_time32;
+static bool           started;
+static uint16_t       last_press_time;
+static bool           last_press_valid;
+static keytrace_key_t keys[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t        bounce[(KEYTRACE_KEYS + 1) / 2];
+static uint8_t        bounce_min_gap = UINT8_MAX;
+static uint8_t        repress[(KEYTRACE_KEYS + 1) / 2];
+static uint8_t        repress_min_gap = UINT8_MAX;
+
+static inline uint8_t ring_next(uint8_t index) { return (index + 1 < KEYTRACE_BUFFER_SIZE) ? index + 1 : 0; }
+
+// Size of the record starting at index
+static uint8_t record_size(uint8_t index) {
+    uint8_t size = 1; // key byte
+
+    while (buffer[index] & 0x80) {
+        index = ring_next(index);
+        size++;
+    }
+    return size + 1;
+}
+
+static void drop_oldest(void) {
+    const uint8_t size = record_size(tail);
+
+    for (uint8_t i = 0; i < size; i++) {
+        tail = ring_next(tail);
+    }
+    used -= size;
+    if (dropped < UINT16_MAX) {
+        dropped++;
+    }
+}
+
+static void push(uint8_t byte) {
+    buffer[head] = byte;
+    head         = ring_next(head);
+    used++;
+}
+
+static inline void ema_update(uint16_t *average, uint16_t sample, bool first) {
+    if (first) {
+        *average = sample;
+    } else {
+        *average += ((int32_t)sample - *average + (1 << (KEYTRACE_EMA_SHIFT - 1))) >> KEYTRACE_EMA_SHIFT;
+    }
+}
+
+static uint8_t nibble_get(const uint8_t *counts, uint8_t index) { return (index & 1) ? counts[index / 2] >> 4 : counts[index / 2] & 0x0F; }
+
+static void nibble_count(uint8_t *counts, uint8_t index) {
+    if (nibble_get(counts, index) < 0x0F) {
+        counts[index / 2] += (index & 1) ? 0x10 : 0x01;
+    }
+}
+
+static void update_stats(keyevent_t *event) {
+    keytrace_key_t *key = &keys[event->key.row][event->key.col];
+
+    if (event->pressed) {
+        const uint16_t interval = event->time - last_press_time;
+
+        const uint16_t gap      = event->time - key->edge_time;
+
+        if (last_press_valid && interval <= KEYTRACE_PAUSE_MS) {
+            ema_update(&key->interval_ms, interval, key->interval_ms == 0);
+        }
+        if (key->presses && gap < KEYTRACE_REPRESS_MS) {
+            nibble_count(repress, event->key.row * MATRIX_COLS + event->key.col);
+            if (gap < repress_min_gap) {
+                repress_min_gap = gap;
+            }
+        }
+        last_press_time  = event->time;
+        last_press_valid = true;
+        key->edge_time   = event->time;
+        if (key->presses < UINT16_MAX) {
+            key->presses++;
+        }
+    } else if (key->presses) {
+        const uint16_t hold = event->time - key->edge_time;
+
+        ema_update(&key->hold_ms, hold, key->presses == 1);
+        key->edge_time = event->time;
+    }
+}
+
+void keytrace_record(keyrecord_t *record) {
+    keyevent_t *event = &record->event;
+
+    if (!IS_KEYEVENT(*event) || event->key.row >= MATRIX_ROWS || event->key.col >= MATRIX_COLS) {
+        return;
+    }
+
+    // event->time wraps every 65 s, timer_read32() tells a long pause from a short one
+    uint32_t delta = (uint16_t)(event->time - last_time);
+    if (!started) {
+        delta = 0;
+    } else if (timer_elapsed32(last_time32) > UINT16_MAX) {
+        delta = UINT16_MAX;
+    }
+    started     = true;
+    last_time   = event->time;
+    last_time32 = timer_read32();
+
+    uint32_t value = (delta << 1) | event->pressed;
+    while (KEYTRACE_BUFFER_SIZE - used < KEYTRACE_RECORD_MAX) {
+        drop_oldest();
+    }
+    while (value >= 0x80) {
+        push((uint8_t)value | 0x80);
+        value >>= 7;
+    }
+    push((uint8_t)value);
+    push((event->key.row << 4) | event->key.col);
+
+    update_stats(event);
+}
+
+uint8_t keytrace_read(uint8_t *data, uint8_t length) {
+    uint8_t count = 0;
+
+    while (used) {
+        const uint8_t size = record_size(tail);
+
+        if (count + size > length) {
+            break;
+        }
+        for (uint8_t i = 0; i < size; i++) {
+            data[count++] = buffer[tail];
+            tail          = ring_next(tail);
+        }
+        used -= size;
+    }
+    return count;
+}
+
+uint16_t keytrace_dropped(void) { return dropped; }
+
+bool keytrace_key_stats(uint8_t row, uint8_t col, keytrace_stats_t *stats) {
+    if (row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+        return false;
+    }
+    const keytrace_key_t *key = &keys[row][col];
+
+    stats->presses     = key->presses;
+    stats->hold_ms     = key->hold_ms;
+    stats->interval_ms = key->interval_ms;
+    stats->bounce      = nibble_get(bounce, row * MATRIX_COLS + col);
+    stats->repress     = nibble_get(repress, row * MATRIX_COLS + col);
+    return true;
+}
+
+uint8_t keytrace_repress_min_gap(void) { return repress_min_gap; }
+
+void keytrace_bounce(uint8_t row, matrix_row_t mask, uint8_t gap_ms) {
+    if (row >= MATRIX_ROWS) {
+        return;
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (mask & ((matrix_row_t)1 << col)) {
+            nibble_count(bounce, row * MATRIX_COLS + col);
+        }
+    }
+    if (gap_ms < bounce_min_gap) {
+        bounce_min_gap = gap_ms;
+    }
+}
+
+uint8_t keytrace_bounce_min_gap(void) { return bounce_min_gap; }
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "action.h"
+#include "matrix.h"
+
+// RAM trace of the key events (keytrace.c), for tuning debounce, tapping
+// term and scan rates from real typing.
+//
+// Record: varint(delta_ms << 1 | pressed), then (row << 4 | col).
+// The varint is little endian base 128, bit 7 set on all but the last byte,
+// so a record is 2 bytes below 64 ms between events and at most 4 bytes.
+// A gap longer than 65535 ms is recorded as 65535 ms.
+
+#ifndef KEYTRACE_BUFFER_SIZE
+#    define KEYTRACE_BUFFER_SIZE 128
+#endif
+
+// Inter-key intervals longer than this are pauses, not typing
+#ifndef KEYTRACE_PAUSE_MS
+#    define KEYTRACE_PAUSE_MS 1000
+#endif
+
+// A press this soon after the release of the same key is counted as a
+// re-press. These are reported events, after debounce: a double press that got
+// through it. The bounces debounce hides are counted by keytrace_debounce.c.
+#ifndef KEYTRACE_REPRESS_MS
+#    define KEYTRACE_REPRESS_MS 20
+#endif
+
+typedef struct {
+    uint16_t presses;
+    uint16_t hold_ms;     // moving average of the hold time
+    uint16_t interval_ms; // moving average of the time since the previous press of any key
+    uint8_t  bounce;      // raw changes inside the debounce window, saturating at 15
+    uint8_t  repress;     // presses within KEYTRACE_REPRESS_MS of the release, saturating at 15
+} keytrace_stats_t;
+
+void keytrace_record(keyrecord_t *record);
+
+// Move whole records, oldest first, into data; returns the number of bytes
+uint8_t keytrace_read(uint8_t *data, uint8_t length);
+
+// Records overwritten before they were read
+uint16_t keytrace_dropped(void);
+
+bool keytrace_key_stats(uint8_t row, uint8_t col, keytrace_stats_t *stats);
+
+// Shortest release to press gap counted as a re-press [ms], 255 if none
+uint8_t keytrace_repress_min_gap(void);
+
+// Raw changes of the keys in mask, gap_ms after the debounce window opened
+// (keytrace_debounce.c); row is the row of the whole matrix
+void keytrace_bounce(uint8_t row, matrix_row_t mask, uint8_t gap_ms);
+
+// Shortest time from the opening of the debounce window to a bounce [ms], 255 if none
+uint8_t keytrace_bounce_min_gap(void);
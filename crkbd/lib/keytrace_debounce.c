@@ -0,0 +1,90 @@
+#include "quantum.h"
+#include "debounce.h"
+#include "keytrace.h"
+
+// QMK's default debounce (sym_defer_g: the matrix is reported once it has not
+// changed for DEBOUNCE ms) with the raw matrix side of the keytrace chatter
+// statistics, built as DEBOUNCE_TYPE = custom.
+//
+// A key that changes again after its first change in an open window is a
+// bounce the cooked matrix never shows. Each one is passed to keytrace_bounce()
+// with the time since the window opened, the first raw change after the matrix
+// was reported. A change of another key holds the window open, so a gap can be
+// longer than the key's own bounce, never shorter.
+//
+// The scan only covers this half's rows. keytrace is read on the master, so
+// the counts are those of the keys of the half connected to USB.
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+#if DEBOUNCE > 0
+static bool         debouncing;
+static uint16_t     debouncing_time; // last raw change
+static uint16_t     window_start;    // first raw change since the matrix was reported
+static matrix_row_t previous_raw[MATRIX_ROWS];
+static matrix_row_t changed_keys[MATRIX_ROWS]; // keys that changed in the open window
+
+static void bounce_scan(matrix_row_t raw[], uint8_t num_rows) {
+    const uint16_t elapsed = timer_elapsed(window_start);
+    const uint8_t  gap     = (elapsed < UINT8_MAX) ? elapsed : UINT8_MAX;
+#    ifdef SPLIT_KEYBOARD
+    const uint8_t offset = is_keyboard_left() ? 0 : num_rows;
+#    else
+    const uint8_t offset = 0;
+#    endif
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        const matrix_row_t change  = raw[row] ^ previous_raw[row];
+        const matrix_row_t bounced = change & changed_keys[row];
+
+        if (bounced) {
+            keytrace_bounce(offset + row, bounced, gap);
+        }
+        changed_keys[row] |= change;
+        previous_raw[row] = raw[row];
+    }
+}
+#endif
+
+void debounce_init(uint8_t num_rows) {
+#if DEBOUNCE > 0
+    for (uint8_t row = 0; row < num_rows; row++) {
+        previous_raw[row] = 0;
+        changed_keys[row] = 0;
+    }
+    debouncing = false;
+#endif
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    const size_t size           = num_rows * sizeof(matrix_row_t);
+    bool         cooked_changed = false;
+
+#if DEBOUNCE > 0
+    if (changed) {
+        if (!debouncing) {
+            window_start = timer_read();
+        }
+        bounce_scan(raw, num_rows);
+        debouncing      = true;
+        debouncing_time = timer_read();
+    } else if (debouncing && timer_elapsed(debouncing_time) >= DEBOUNCE) {
+        if (memcmp(cooked, raw, size) != 0) {
+            memcpy(cooked, raw, size);
+            cooked_changed = true;
+        }
+        memset(changed_keys, 0, size);
+        debouncing = false;
+    }
+#else
+    if (changed && memcmp(cooked, raw, size) != 0) {
+        memcpy(cooked, raw, size);
+        cooked_changed = true;
+    }
+#endif
+    return cooked_changed;
+}
+
+void debounce_free(void) {}
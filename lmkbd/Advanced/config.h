@@ -48,11 +48,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 /* COL2ROW, ROW2COL*/
 #define DIODE_DIRECTION COL2ROW
 
+/* matrix.c reads whole ports per row; keep its column table in sync with MATRIX_COL_PINS */
+// #define SU120_MATRIX_MEASURE_CYCLES /* time each scan with Timer1 (see su120_matrix_scan_cycles()) */
+
 /*
  * Split Keyboard specific options, make sure you have 'SPLIT_KEYBOARD = yes' in your rules.mk, and define SOFT_SERIAL_PIN.
  */
 #define SOFT_SERIAL_PIN D2 // or D1, D2, D3, E6
 
+/* transport.c sends the slave rows bit-packed; keep in sync with MATRIX_COL_PINS */
+#define SERIAL_USE_MULTI_TRANSACTION
+#define SU120_TRANSPORT_COLS 10
+#define SU120_TRANSPORT_CHANGES_ONLY /* poll a sequence byte, pull the rows only after a change */
+#define SU120_LINK_DOWN_SCANS 3      /* failed scans in a row before the slave keys are released */
+
 // #define BACKLIGHT_PIN B7
 // #define BACKLIGHT_BREATHING
 // #define BACKLIGHT_LEVELS 3
@@ -88,7 +97,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 /* Debounce reduces chatter (unintended double-presses) - set 0 if debouncing is not needed */
+/* debounce.c: presses are reported at once, releases after DEBOUNCE ms of open contact (max 7) */
 #define DEBOUNCE 5
+#define SU120_CHATTER_STATS /* count per-key bounces inside the window, read through VIA (see v1.c) */
 
 /* define if matrix has ghost (lacks anti-ghosting diodes) */
 //#define MATRIX_HAS_GHOST
@@ -0,0 +1,221 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Per-key eager press / deferred release debounce (DEBOUNCE_TYPE = custom).
+ *
+ * A press is reported on the first scan that sees it.  A release is reported
+ * once the key has read open for DEBOUNCE ms in a row, after which the key is
+ * locked for another DEBOUNCE ms so release bounce cannot re-press it.  A key
+ * still closed when its lockout ends is pressed on that scan.
+ *
+ * Every key owns a 3-bit down counter, stored bit-sliced: plane k holds bit k
+ * of the counters of a whole row.  Loading, clearing and decrementing all keys
+ * of a row is then a few word-wide logical operations, whatever the number of
+ * keys that are bouncing.
+ */
+#include "quantum.h"
+#include "matrix.h"
+#include "timer.h"
+#include "debounce.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+#if DEBOUNCE > 7
+#    error "debounce.c: DEBOUNCE must fit in the 3-bit per-key counters (<= 7)"
+#endif
+
+#if DEBOUNCE > 0
+static matrix_row_t counter_b0[MATRIX_ROWS];
+static matrix_row_t counter_b1[MATRIX_ROWS];
+static matrix_row_t counter_b2[MATRIX_ROWS];
+static uint16_t     last_tick;
+static bool         counting;
+
+#    ifdef SU120_CHATTER_STATS
+static matrix_row_t chatter_b0[MATRIX_ROWS];
+static matrix_row_t chatter_b1[MATRIX_ROWS];
+static matrix_row_t chatter_b2[MATRIX_ROWS];
+static matrix_row_t chatter_b3[MATRIX_ROWS];
+static matrix_row_t previous_raw[MATRIX_ROWS];
+static uint8_t      chatter_min_gap = UINT8_MAX;
+#    endif
+
+/* Set the counters selected by mask to DEBOUNCE */
+static inline void counter_load(uint8_t row, matrix_row_t mask) {
+    counter_b0[row] = (DEBOUNCE & 1) ? (counter_b0[row] | mask) : (counter_b0[row] & ~mask);
+    counter_b1[row] = (DEBOUNCE & 2) ? (counter_b1[row] | mask) : (counter_b1[row] & ~mask);
+    counter_b2[row] = (DEBOUNCE & 4) ? (counter_b2[row] | mask) : (counter_b2[row] & ~mask);
+}
+
+static inline void counter_clear(uint8_t row, matrix_row_t mask) {
+    counter_b0[row] &= ~mask;
+    counter_b1[row] &= ~mask;
+    counter_b2[row] &= ~mask;
+}
+
+static inline matrix_row_t counter_active(uint8_t row) { return counter_b0[row] | counter_b1[row] | counter_b2[row]; }
+
+/* Decrement every running counter of the row, return the ones reaching zero */
+static inline matrix_row_t counter_tick(uint8_t row) {
+    const matrix_row_t running = counter_active(row);
+    matrix_row_t       borrow  = running;
+
+    counter_b0[row] ^= borrow;
+    borrow &= counter_b0[row];
+    counter_b1[row] ^= borrow;
+    borrow &= counter_b1[row];
+    counter_b2[row] ^= borrow;
+
+    return running & ~counter_active(row);
+}
+
+#    ifdef SU120_CHATTER_STATS
+/* Add one to the chatter counters selected by mask, saturating at 15 */
+static inline void chatter_count(uint8_t row, matrix_row_t mask) {
+    matrix_row_t carry = mask & ~(chatter_b0[row] & chatter_b1[row] & chatter_b2[row] & chatter_b3[row]);
+
+    chatter_b0[row] ^= carry;
+    carry &= ~chatter_b0[row];
+    chatter_b1[row] ^= carry;
+    carry &= ~chatter_b1[row];
+    chatter_b2[row] ^= carry;
+    carry &= ~chatter_b2[row];
+    chatter_b3[row] ^= carry;
+}
+
+static inline uint8_t counter_value(uint8_t row, uint8_t col) {
+    return ((counter_b0[row] >> col) & 1) | (((counter_b1[row] >> col) & 1) << 1) | (((counter_b2[row] >> col) & 1) << 2);
+}
+
+/* Count the keys that change while their window is open, before this scan's update */
+static void chatter_scan(uint8_t row, matrix_row_t raw_row) {
+    const matrix_row_t bounced = (raw_row ^ previous_raw[row]) & counter_active(row);
+
+    previous_raw[row] = raw_row;
+    if (!bounced) {
+        return;
+    }
+    chatter_count(row, bounced);
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (bounced & ((matrix_row_t)1 << col)) {
+            const uint8_t gap = DEBOUNCE - counter_value(row, col);
+
+            if (gap < chatter_min_gap) {
+                chatter_min_gap = gap;
+            }
+        }
+    }
+}
+
+uint8_t su120_chatter_count(uint8_t row, uint8_t col) {
+    if (row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+        return 0;
+    }
+    return ((chatter_b0[row] >> col) & 1) | (((chatter_b1[row] >> col) & 1) << 1) | (((chatter_b2[row] >> col) & 1) << 2) |
+           (((chatter_b3[row] >> col) & 1) << 3);
+}
+
+uint8_t su120_chatter_min_gap(void) { return chatter_min_gap; }
+
+void su120_chatter_clear(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        chatter_b0[row] = 0;
+        chatter_b1[row] = 0;
+        chatter_b2[row] = 0;
+        chatter_b3[row] = 0;
+    }
+    chatter_min_gap = UINT8_MAX;
+}
+#    endif
+#endif
+
+void debounce_init(uint8_t num_rows) {
+#if DEBOUNCE > 0
+    for (uint8_t row = 0; row < num_rows; row++) {
+        counter_b0[row] = 0;
+        counter_b1[row] = 0;
+        counter_b2[row] = 0;
+    }
+    last_tick = timer_read();
+    counting  = false;
+#endif
+}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+#if DEBOUNCE > 0
+    uint16_t elapsed = timer_elapsed(last_tick);
+
+    if (!changed && !counting) {
+        last_tick = timer_read();
+        return;
+    }
+    if (elapsed > DEBOUNCE) {
+        elapsed   = DEBOUNCE;
+        last_tick = timer_read();
+    } else {
+        last_tick += elapsed;
+    }
+
+    counting = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        const matrix_row_t raw_row    = raw[row];
+        matrix_row_t       cooked_row = cooked[row];
+        const matrix_row_t idle       = ~counter_active(row);
+
+#    ifdef SU120_CHATTER_STATS
+        chatter_scan(row, raw_row);
+#    endif
+
+        /* Held keys that read closed cancel a pending release */
+        counter_clear(row, cooked_row & raw_row);
+        /* Held keys that start reading open arm their release timer */
+        counter_load(row, cooked_row & ~raw_row & idle);
+        /* Idle keys that read closed are pressed right away */
+        cooked_row |= ~cooked_row & raw_row & idle;
+
+        for (uint8_t tick = 0; tick < elapsed; tick++) {
+            const matrix_row_t release = counter_tick(row) & cooked_row;
+
+            cooked_row &= ~release;
+            counter_load(row, release); /* lock out release bounce */
+        }
+        /* Keys closed through a lockout that just ended are pressed now */
+        cooked_row |= raw_row & ~cooked_row & ~counter_active(row);
+
+        cooked[row] = cooked_row;
+        counting |= (counter_active(row) != 0);
+    }
+#else
+    if (changed) {
+        for (uint8_t row = 0; row < num_rows; row++) {
+            cooked[row] = raw[row];
+        }
+    }
+#endif
+}
+
+bool debounce_active(void) {
+#if DEBOUNCE > 0
+    return counting;
+#else
+    return false;
+#endif
+}
+
+void debounce_free(void) {}
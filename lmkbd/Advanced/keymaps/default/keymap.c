@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include QMK_KEYBOARD_H
+#include "send_string_queue.h"
 
 enum preonic_layers {
   _QWERTY,
@@ -105,7 +106,7 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
     case SEND_00:
       if (record->event.pressed) {
         // when keycode SEND_00 is pressed
-        SEND_STRING("00");
+        SEND_STRING_ASYNC("00");
       } else {
         // when keycode SEND_00 is released
       }
@@ -113,8 +114,8 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
     case SEND_000:
       if (record->event.pressed) {
         // when keycode SEND_000 is pressed
-        //SEND_STRING("000" SS_TAP(X_ENTER));
-        SEND_STRING("000");
+        //SEND_STRING_ASYNC("000" SS_TAP(X_ENTER));
+        SEND_STRING_ASYNC("000");
       } else {
         // when keycode SEND_000 is released
       }
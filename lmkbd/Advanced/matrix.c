@@ -0,0 +1,128 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quantum.h"
+#include "matrix.h"
+
+/*
+ * Port-level matrix scan (CUSTOM_MATRIX = lite).
+ *
+ * The generic matrix code reads MATRIX_COL_PINS one pin at a time.  Here each
+ * row is selected once, the five input ports are sampled back to back and the
+ * column bits are gathered with constant masks and shifts, which the compiler
+ * folds into a few bit moves per column.
+ *
+ * SU120_COL_TABLE must list the same pins, in the same order, as
+ * MATRIX_COL_PINS in config.h:
+ *   { D1, D0, D4, C6, D7, E6, B4, B5, F4, F5 }
+ */
+
+#ifndef MATRIX_IO_DELAY
+#    define MATRIX_IO_DELAY 30
+#endif
+
+/*        port bit col */
+#define SU120_COL_TABLE(X) \
+    X(D,   1,  0) \
+    X(D,   0,  1) \
+    X(D,   4,  2) \
+    X(C,   6,  3) \
+    X(D,   7,  4) \
+    X(E,   6,  5) \
+    X(B,   4,  6) \
+    X(B,   5,  7) \
+    X(F,   4,  8) \
+    X(F,   5,  9)
+
+/* Shift by a signed constant; the dead branch is folded away */
+#define SU120_SHIFT(value, n) \
+    ((n) >= 0 ? (matrix_row_t)(value) << ((n) & 0x0F) : (matrix_row_t)(value) >> ((-(n)) & 0x0F))
+
+/* Move <bit> of a sampled port to column <col> of the row */
+#define SU120_COL_BIT(port, bit, col) | SU120_SHIFT(pin_##port & (1U << (bit)), (col) - (bit))
+
+static const pin_t row_pins[MATRIX_ROWS / 2] = MATRIX_ROW_PINS;
+static const pin_t col_pins[]                = MATRIX_COL_PINS;
+
+#ifdef SU120_MATRIX_MEASURE_CYCLES
+static uint16_t su120_scan_cycles_last = 0;
+static uint16_t su120_scan_cycles_max  = 0;
+
+uint16_t su120_matrix_scan_cycles(void) { return su120_scan_cycles_last; }
+
+uint16_t su120_matrix_scan_cycles_max(void) { return su120_scan_cycles_max; }
+#endif
+
+static inline void select_row(uint8_t row) {
+    setPinOutput(row_pins[row]);
+    writePinLow(row_pins[row]);
+}
+
+static inline void unselect_row(uint8_t row) { setPinInputHigh(row_pins[row]); }
+
+static inline matrix_row_t read_cols(void) {
+    /* Columns are pulled up, a pressed key reads low */
+    const uint8_t pin_B = ~PINB;
+    const uint8_t pin_C = ~PINC;
+    const uint8_t pin_D = ~PIND;
+    const uint8_t pin_E = ~PINE;
+    const uint8_t pin_F = ~PINF;
+
+    return 0 SU120_COL_TABLE(SU120_COL_BIT);
+}
+
+void matrix_init_custom(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS / 2; row++) {
+        unselect_row(row);
+    }
+    for (uint8_t col = 0; col < sizeof(col_pins) / sizeof(col_pins[0]); col++) {
+        setPinInputHigh(col_pins[col]);
+    }
+
+#ifdef SU120_MATRIX_MEASURE_CYCLES
+    /* Timer1 free running at F_CPU, only used to time the scan */
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+#endif
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    bool changed = false;
+
+#ifdef SU120_MATRIX_MEASURE_CYCLES
+    const uint16_t start = TCNT1;
+#endif
+
+    for (uint8_t row = 0; row < MATRIX_ROWS / 2; row++) {
+        select_row(row);
+        wait_us(MATRIX_IO_DELAY);
+
+        const matrix_row_t cols = read_cols();
+
+        unselect_row(row);
+
+        changed |= (current_matrix[row] != cols);
+        current_matrix[row] = cols;
+    }
+
+#ifdef SU120_MATRIX_MEASURE_CYCLES
+    su120_scan_cycles_last = TCNT1 - start;
+    if (su120_scan_cycles_last > su120_scan_cycles_max) {
+        su120_scan_cycles_max = su120_scan_cycles_last;
+    }
+#endif
+
+    return changed;
+}
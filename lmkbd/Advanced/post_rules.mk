@@ -0,0 +1,9 @@
+# Read after the keymap rules.mk, so the keymap options below are known here
+
+# Sparse overlay layers (see sparse_keymap.h), set SPARSE_KEYMAP_ENABLE = yes in the keymap rules.mk
+ifeq ($(strip $(SPARSE_KEYMAP_ENABLE)), yes)
+    ifeq ($(strip $(VIA_ENABLE)), yes)
+        $(error SPARSE_KEYMAP_ENABLE: VIA reads the keymap from EEPROM, seeded from the dense keymaps[], set VIA_ENABLE = no)
+    endif
+    SRC += sparse_keymap.c
+endif
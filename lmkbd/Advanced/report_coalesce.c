@@ -0,0 +1,106 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quantum.h"
+#include "host.h"
+#include "host_driver.h"
+
+/*
+ * NKRO report coalescing.
+ *
+ * Every key event of a scan rewrites the NKRO bitmap and asks the host driver
+ * to send it, so a chord or a rollover burst costs one USB report per key.
+ * The USB driver is wrapped so that NKRO reports only update a pending copy;
+ * su120_report_coalesce_task() sends it at the start of the next scan, at most
+ * once per millisecond (one full-speed USB frame).
+ *
+ * A key that is pressed and released before the pending report goes out would
+ * never be seen by the host, so a bit about to flip back sends the pending
+ * report first.  Boot protocol (6KRO) reports are passed through unchanged.
+ */
+
+static host_driver_t     su120_driver;
+static host_driver_t    *usb_driver;
+static report_keyboard_t sent_report;
+static report_keyboard_t pending_report;
+static bool              pending;
+static uint16_t          flush_tick;
+static uint16_t          reports_sent;
+static uint16_t          reports_coalesced;
+
+uint16_t su120_reports_sent(void) { return reports_sent; }
+
+uint16_t su120_reports_coalesced(void) { return reports_coalesced; }
+
+static void flush(void) {
+    sent_report = pending_report;
+    pending     = false;
+    flush_tick  = timer_read();
+    reports_sent++;
+    (*usb_driver->send_keyboard)(&sent_report);
+}
+
+/* True if a bit changed by the pending report would be changed back by next */
+static bool toggles_twice(const report_keyboard_t *next) {
+    const uint8_t *sent = (const uint8_t *)&sent_report;
+    const uint8_t *pend = (const uint8_t *)&pending_report;
+    const uint8_t *new  = (const uint8_t *)next;
+
+    for (uint8_t i = 0; i < sizeof(report_keyboard_t); i++) {
+        if ((sent[i] ^ pend[i]) & (pend[i] ^ new[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void send_keyboard_coalesced(report_keyboard_t *report) {
+    if (!(keyboard_protocol && keymap_config.nkro)) {
+        if (pending) {
+            flush();
+        }
+        (*usb_driver->send_keyboard)(report);
+        return;
+    }
+
+    if (pending) {
+        if (toggles_twice(report)) {
+            flush();
+        } else {
+            reports_coalesced++;
+        }
+    }
+    pending_report = *report;
+    pending        = true;
+}
+
+void su120_report_coalesce_task(void) {
+    host_driver_t *driver = host_get_driver();
+
+    /* The USB driver is registered after keyboard_init(), wrap it on first use */
+    if (driver != &su120_driver) {
+        if (driver == NULL) {
+            return;
+        }
+        usb_driver                 = driver;
+        su120_driver               = *driver;
+        su120_driver.send_keyboard = send_keyboard_coalesced;
+        host_set_driver(&su120_driver);
+    }
+
+    if (pending && timer_read() != flush_tick) {
+        flush();
+    }
+}
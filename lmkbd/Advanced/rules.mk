@@ -80,3 +80,24 @@ FAUXCLICKY_ENABLE = no      # Use buzzer to emulate clicky switches
 HD44780_ENABLE = no         # Enable support for HD44780 based LCDs (+400)
 LTO_ENABLE = yes
 SPLIT_KEYBOARD = yes
+
+# Port-level matrix scan (see matrix.c)
+CUSTOM_MATRIX = lite
+SRC += matrix.c
+
+# Bit-packed slave matrix over soft serial (see transport.c)
+SPLIT_TRANSPORT = custom
+SRC += transport.c
+QUANTUM_LIB_SRC += $(QUANTUM_DIR)/split_common/serial.c
+
+# Per-key eager press / deferred release debounce (see debounce.c)
+DEBOUNCE_TYPE = custom
+SRC += debounce.c
+
+# Non-blocking SEND_STRING_ASYNC() (see send_string_queue.h)
+SRC += send_string_queue.c
+
+# One NKRO report per scan / USB frame (see report_coalesce.c)
+ifeq ($(strip $(NKRO_ENABLE)), yes)
+    SRC += report_coalesce.c
+endif
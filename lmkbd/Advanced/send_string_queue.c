@@ -0,0 +1,125 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quantum.h"
+#include "send_string_queue.h"
+
+#ifndef PGM_LOADBIT
+#    define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+#endif
+
+static const char *queue[SEND_STRING_QUEUE_SIZE];
+static uint8_t     queue_head;
+static uint8_t     queue_count;
+
+static const char *cursor;    /* next character of the string being played */
+static uint8_t     held_key;  /* tapped key to release on the next step */
+static bool        held_shift;
+static uint16_t    step_tick;
+static uint16_t    delay_ms;  /* SS_DELAY() still to wait, from step_tick */
+
+bool send_string_queue_P(const char *str) {
+    if (queue_count == SEND_STRING_QUEUE_SIZE) {
+        return false;
+    }
+    queue[(queue_head + queue_count) % SEND_STRING_QUEUE_SIZE] = str;
+    queue_count++;
+    return true;
+}
+
+bool send_string_queue_busy(void) { return cursor != NULL || queue_count != 0 || held_key != KC_NO; }
+
+/* Press the next key of the string; returns false when all strings are done */
+static bool press_next(void) {
+    for (;;) {
+        if (cursor == NULL) {
+            if (queue_count == 0) {
+                return false;
+            }
+            cursor     = queue[queue_head];
+            queue_head = (queue_head + 1) % SEND_STRING_QUEUE_SIZE;
+            queue_count--;
+        }
+
+        uint8_t c = pgm_read_byte(cursor);
+
+        switch (c) {
+            case '\0':
+                cursor = NULL;
+                continue;
+            case SS_TAP_CODE:
+                held_key = pgm_read_byte(++cursor);
+                register_code(held_key);
+                break;
+            case SS_DOWN_CODE:
+                register_code(pgm_read_byte(++cursor));
+                break;
+            case SS_UP_CODE:
+                unregister_code(pgm_read_byte(++cursor));
+                break;
+#ifdef SS_DELAY_CODE
+            case SS_DELAY_CODE:
+                /* SS_DELAY(ms): decimal digits terminated by '|' */
+                delay_ms = 0;
+                while ((c = pgm_read_byte(++cursor)) != '|' && c != '\0') {
+                    delay_ms = delay_ms * 10 + (c - '0');
+                }
+                if (c == '\0') {
+                    continue;
+                }
+                break;
+#endif
+            default:
+                if (c & 0x80) {
+                    cursor++; /* not ASCII, skip */
+                    continue;
+                }
+                held_key   = pgm_read_byte(&ascii_to_keycode_lut[c]);
+                held_shift = PGM_LOADBIT(ascii_to_shift_lut, c);
+                if (held_shift) {
+                    add_weak_mods(MOD_BIT(KC_LSFT));
+                }
+                register_code(held_key);
+                break;
+        }
+        cursor++;
+        return true;
+    }
+}
+
+/* One keyboard report per call, at most once per millisecond */
+void send_string_queue_task(void) {
+    if (!send_string_queue_busy() || timer_read() == step_tick) {
+        return;
+    }
+    if (delay_ms) {
+        if (timer_elapsed(step_tick) < delay_ms) {
+            return;
+        }
+        delay_ms = 0;
+    }
+    step_tick = timer_read();
+
+    if (held_key != KC_NO) {
+        if (held_shift) {
+            del_weak_mods(MOD_BIT(KC_LSFT));
+            held_shift = false;
+        }
+        unregister_code(held_key);
+        held_key = KC_NO;
+        return;
+    }
+    press_next();
+}
@@ -0,0 +1,41 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "quantum.h"
+
+/*
+ * Non-blocking SEND_STRING.
+ *
+ * SEND_STRING() taps every key with blocking delays, so nothing is scanned
+ * while a macro plays.  SEND_STRING_ASYNC() only queues the PROGMEM string;
+ * send_string_queue_task(), called once per scan from matrix_scan_kb(), plays
+ * it back one keyboard report per millisecond.  Keys pressed meanwhile are
+ * scanned and processed as usual.
+ *
+ * The string may use SS_TAP(), SS_DOWN() and SS_UP() like SEND_STRING().
+ */
+
+#ifndef SEND_STRING_QUEUE_SIZE
+#    define SEND_STRING_QUEUE_SIZE 4
+#endif
+
+#define SEND_STRING_ASYNC(string) send_string_queue_P(PSTR(string))
+
+/* Returns false if the queue is full and the string was dropped */
+bool send_string_queue_P(const char *str);
+bool send_string_queue_busy(void);
+void send_string_queue_task(void);
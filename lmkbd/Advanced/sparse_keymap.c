@@ -0,0 +1,59 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "quantum.h"
+#include "sparse_keymap.h"
+
+/*
+ * Keycode lookup for sparse overlay layers (see sparse_keymap.h).
+ *
+ * Layers below SPARSE_KEYMAP_FIRST_LAYER come from the dense keymaps[] table,
+ * the following sparse_layer_count layers from sparse_layers[].  Layers past
+ * the end are transparent.
+ */
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    error "sparse_keymap.c: VIA keymaps are seeded from the dense keymaps[], see sparse_keymap.h"
+#endif
+
+uint16_t sparse_keymap_keycode(uint8_t layer, keypos_t key) {
+    const sparse_layer_t *sparse = &sparse_layers[layer - SPARSE_KEYMAP_FIRST_LAYER];
+    const matrix_row_t    mask   = pgm_read_word(&sparse->row_mask[key.row]);
+    const matrix_row_t    bit    = (matrix_row_t)1 << key.col;
+
+    if (!(mask & bit)) {
+        return pgm_read_word(&sparse->fill_keycode);
+    }
+
+    /* Rank of the key among the overrides of its row */
+    uint8_t      index = pgm_read_byte(&sparse->row_base[key.row]);
+    matrix_row_t below = mask & (bit - 1);
+
+    while (below) {
+        below &= below - 1;
+        index++;
+    }
+    return pgm_read_word(&sparse->keycodes[index]);
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (layer < SPARSE_KEYMAP_FIRST_LAYER) {
+        return pgm_read_word(&keymaps[layer][key.row][key.col]);
+    }
+    if (layer - SPARSE_KEYMAP_FIRST_LAYER < sparse_layer_count) {
+        return sparse_keymap_keycode(layer, key);
+    }
+    return KC_TRNS;
+}
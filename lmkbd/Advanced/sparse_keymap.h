@@ -0,0 +1,323 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "quantum.h"
+
+/*
+ * Sparse overlay layers.
+ *
+ * Overlay layers are mostly one keycode (XXXXXXX or _______).  Instead of a
+ * dense MATRIX_ROWS x MATRIX_COLS table, a sparse layer keeps
+ *   - fill_keycode: the keycode of every position that is not overridden,
+ *   - row_mask: one bit per overridden position,
+ *   - row_base: the index of the first override of each row,
+ *   - keycodes: the overrides, sorted by (row, col).
+ * The index of an override is row_base[row] plus the number of mask bits
+ * below its column, so a lookup is one mask test for a fill key and a short
+ * popcount for an override.
+ *
+ * SPARSE_LAYOUT() takes the fill keycode followed by the same 120 arguments
+ * as LAYOUT() and builds the tables at compile time:
+ *
+ *   #pragma GCC diagnostic push
+ *   #pragma GCC diagnostic ignored "-Woverride-init"
+ *   const sparse_layer_t PROGMEM sparse_layers[] = {
+ *       SPARSE_LAYOUT(XXXXXXX, ...),   // layer SPARSE_KEYMAP_FIRST_LAYER
+ *   };
+ *   #pragma GCC diagnostic pop
+ *
+ * Every position that is not overridden is initialized into one scratch slot
+ * past the overrides, so later ones override earlier ones: -Woverride-init is
+ * silenced around the table only (a _Pragma cannot sit inside an initializer).
+ *
+ * A layer with more than SPARSE_KEYMAP_MAX_KEYS overrides fails to compile
+ * ("array index in initializer exceeds array bounds").
+ *
+ * The keymap opts in with SPARSE_KEYMAP_ENABLE = yes in its rules.mk, keeps
+ * the layers below SPARSE_KEYMAP_FIRST_LAYER in keymaps[] and defines
+ * sparse_layers[] and sparse_layer_count.
+ *
+ * Not for VIA keymaps: with DYNAMIC_KEYMAP_ENABLE keycodes come from EEPROM,
+ * which dynamic_keymap_reset() seeds from keymaps[] itself, so every layer has
+ * to stay dense there (post_rules.mk stops such a build).
+ */
+
+#ifndef SPARSE_KEYMAP_FIRST_LAYER
+#    define SPARSE_KEYMAP_FIRST_LAYER 1
+#endif
+#ifndef SPARSE_KEYMAP_MAX_KEYS
+#    define SPARSE_KEYMAP_MAX_KEYS 16
+#endif
+
+typedef struct {
+    uint16_t     fill_keycode;
+    matrix_row_t row_mask[MATRIX_ROWS];
+    uint8_t      row_base[MATRIX_ROWS];
+    uint16_t     keycodes[SPARSE_KEYMAP_MAX_KEYS + 1]; /* last slot collects dropped keys */
+} sparse_layer_t;
+
+extern const sparse_layer_t PROGMEM sparse_layers[];
+extern const uint8_t                sparse_layer_count;
+
+uint16_t sparse_keymap_keycode(uint8_t layer, keypos_t key);
+
+#define SPARSE_LAYOUT(fill, ...) SPARSE_LAYOUT_IMPL(fill, __VA_ARGS__)
+
+/* Lets a layer defined as a macro be expanded by LAYOUT() as well */
+#define LAYOUT_wrapper(...) LAYOUT(__VA_ARGS__)
+
+#define SPARSE_KEEP(fill, kc) ((kc) != (fill))
+
+#define SPARSE_ROW_MASK(fill, k0, k1, k2, k3, k4, k5, k6, k7, k8, k9) \
+    ((matrix_row_t)( \
+        (SPARSE_KEEP(fill, k0) << 0) | \
+        (SPARSE_KEEP(fill, k1) << 1) | \
+        (SPARSE_KEEP(fill, k2) << 2) | \
+        (SPARSE_KEEP(fill, k3) << 3) | \
+        (SPARSE_KEEP(fill, k4) << 4) | \
+        (SPARSE_KEEP(fill, k5) << 5) | \
+        (SPARSE_KEEP(fill, k6) << 6) | \
+        (SPARSE_KEEP(fill, k7) << 7) | \
+        (SPARSE_KEEP(fill, k8) << 8) | \
+        (SPARSE_KEEP(fill, k9) << 9) \
+    ))
+
+#define SPARSE_ROW_COUNT(fill, k0, k1, k2, k3, k4, k5, k6, k7, k8, k9) \
+    (SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2) + SPARSE_KEEP(fill, k3) + SPARSE_KEEP(fill, k4) + SPARSE_KEEP(fill, k5) + SPARSE_KEEP(fill, k6) + SPARSE_KEEP(fill, k7) + SPARSE_KEEP(fill, k8) + SPARSE_KEEP(fill, k9))
+
+/* Overrides go to their rank in the list, dropped keys to the scratch slot.
+ * An override ranked SPARSE_KEYMAP_MAX_KEYS or more is sent past the scratch
+ * slot, out of the array, so it fails to compile instead of being dropped. */
+#define SPARSE_ENTRY(fill, index, kc) \
+    [SPARSE_KEEP(fill, kc) ? ((index) < SPARSE_KEYMAP_MAX_KEYS ? (index) : SPARSE_KEYMAP_MAX_KEYS + 1) : SPARSE_KEYMAP_MAX_KEYS] = (kc)
+
+#define SPARSE_ROW_ENTRIES(fill, base, k0, k1, k2, k3, k4, k5, k6, k7, k8, k9) \
+    SPARSE_ENTRY(fill, (base), k0), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0), k1), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1), k2), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2), k3), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2) + SPARSE_KEEP(fill, k3), k4), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2) + SPARSE_KEEP(fill, k3) + SPARSE_KEEP(fill, k4), k5), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2) + SPARSE_KEEP(fill, k3) + SPARSE_KEEP(fill, k4) + SPARSE_KEEP(fill, k5), k6), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2) + SPARSE_KEEP(fill, k3) + SPARSE_KEEP(fill, k4) + SPARSE_KEEP(fill, k5) + SPARSE_KEEP(fill, k6), k7), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2) + SPARSE_KEEP(fill, k3) + SPARSE_KEEP(fill, k4) + SPARSE_KEEP(fill, k5) + SPARSE_KEEP(fill, k6) + SPARSE_KEEP(fill, k7), k8), \
+    SPARSE_ENTRY(fill, (base) + SPARSE_KEEP(fill, k0) + SPARSE_KEEP(fill, k1) + SPARSE_KEEP(fill, k2) + SPARSE_KEEP(fill, k3) + SPARSE_KEEP(fill, k4) + SPARSE_KEEP(fill, k5) + SPARSE_KEEP(fill, k6) + SPARSE_KEEP(fill, k7) + SPARSE_KEEP(fill, k8), k9)
+
+#define SPARSE_LAYOUT_IMPL( \
+    fill, \
+    l00, l01, l02, l03, l04, l05, l06, l07, l08, l09, \
+    l10, l11, l12, l13, l14, l15, l16, l17, l18, l19, \
+    l20, l21, l22, l23, l24, l25, l26, l27, l28, l29, \
+    l30, l31, l32, l33, l34, l35, l36, l37, l38, l39, \
+    l40, l41, l42, l43, l44, l45, l46, l47, l48, l49, \
+    l50, l51, l52, l53, l54, l55, l56, l57, l58, l59, \
+    r00, r01, r02, r03, r04, r05, r06, r07, r08, r09, \
+    r10, r11, r12, r13, r14, r15, r16, r17, r18, r19, \
+    r20, r21, r22, r23, r24, r25, r26, r27, r28, r29, \
+    r30, r31, r32, r33, r34, r35, r36, r37, r38, r39, \
+    r40, r41, r42, r43, r44, r45, r46, r47, r48, r49, \
+    r50, r51, r52, r53, r54, r55, r56, r57, r58, r59 \
+  ) \
+  { \
+    .fill_keycode = (fill), \
+    .row_mask = { \
+      SPARSE_ROW_MASK(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09), \
+      SPARSE_ROW_MASK(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19), \
+      SPARSE_ROW_MASK(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29), \
+      SPARSE_ROW_MASK(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39), \
+      SPARSE_ROW_MASK(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49), \
+      SPARSE_ROW_MASK(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59), \
+      SPARSE_ROW_MASK(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09), \
+      SPARSE_ROW_MASK(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19), \
+      SPARSE_ROW_MASK(fill, r20, r21, r22, r23, r24, r25, r26, r27, r28, r29), \
+      SPARSE_ROW_MASK(fill, r30, r31, r32, r33, r34, r35, r36, r37, r38, r39), \
+      SPARSE_ROW_MASK(fill, r40, r41, r42, r43, r44, r45, r46, r47, r48, r49), \
+      SPARSE_ROW_MASK(fill, r50, r51, r52, r53, r54, r55, r56, r57, r58, r59) \
+    }, \
+    .row_base = { \
+      (uint8_t)(0), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19) \
+        + SPARSE_ROW_COUNT(fill, r20, r21, r22, r23, r24, r25, r26, r27, r28, r29)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19) \
+        + SPARSE_ROW_COUNT(fill, r20, r21, r22, r23, r24, r25, r26, r27, r28, r29) \
+        + SPARSE_ROW_COUNT(fill, r30, r31, r32, r33, r34, r35, r36, r37, r38, r39)), \
+      (uint8_t)(0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19) \
+        + SPARSE_ROW_COUNT(fill, r20, r21, r22, r23, r24, r25, r26, r27, r28, r29) \
+        + SPARSE_ROW_COUNT(fill, r30, r31, r32, r33, r34, r35, r36, r37, r38, r39) \
+        + SPARSE_ROW_COUNT(fill, r40, r41, r42, r43, r44, r45, r46, r47, r48, r49)) \
+    }, \
+    .keycodes = { \
+      SPARSE_ROW_ENTRIES(fill, 0, \
+        l00, l01, l02, l03, l04, l05, l06, l07, l08, l09), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09), \
+        l10, l11, l12, l13, l14, l15, l16, l17, l18, l19), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19), \
+        l20, l21, l22, l23, l24, l25, l26, l27, l28, l29), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29), \
+        l30, l31, l32, l33, l34, l35, l36, l37, l38, l39), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39), \
+        l40, l41, l42, l43, l44, l45, l46, l47, l48, l49), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49), \
+        l50, l51, l52, l53, l54, l55, l56, l57, l58, l59), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59), \
+        r00, r01, r02, r03, r04, r05, r06, r07, r08, r09), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09), \
+        r10, r11, r12, r13, r14, r15, r16, r17, r18, r19), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19), \
+        r20, r21, r22, r23, r24, r25, r26, r27, r28, r29), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19) \
+        + SPARSE_ROW_COUNT(fill, r20, r21, r22, r23, r24, r25, r26, r27, r28, r29), \
+        r30, r31, r32, r33, r34, r35, r36, r37, r38, r39), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19) \
+        + SPARSE_ROW_COUNT(fill, r20, r21, r22, r23, r24, r25, r26, r27, r28, r29) \
+        + SPARSE_ROW_COUNT(fill, r30, r31, r32, r33, r34, r35, r36, r37, r38, r39), \
+        r40, r41, r42, r43, r44, r45, r46, r47, r48, r49), \
+      SPARSE_ROW_ENTRIES(fill, 0 \
+        + SPARSE_ROW_COUNT(fill, l00, l01, l02, l03, l04, l05, l06, l07, l08, l09) \
+        + SPARSE_ROW_COUNT(fill, l10, l11, l12, l13, l14, l15, l16, l17, l18, l19) \
+        + SPARSE_ROW_COUNT(fill, l20, l21, l22, l23, l24, l25, l26, l27, l28, l29) \
+        + SPARSE_ROW_COUNT(fill, l30, l31, l32, l33, l34, l35, l36, l37, l38, l39) \
+        + SPARSE_ROW_COUNT(fill, l40, l41, l42, l43, l44, l45, l46, l47, l48, l49) \
+        + SPARSE_ROW_COUNT(fill, l50, l51, l52, l53, l54, l55, l56, l57, l58, l59) \
+        + SPARSE_ROW_COUNT(fill, r00, r01, r02, r03, r04, r05, r06, r07, r08, r09) \
+        + SPARSE_ROW_COUNT(fill, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19) \
+        + SPARSE_ROW_COUNT(fill, r20, r21, r22, r23, r24, r25, r26, r27, r28, r29) \
+        + SPARSE_ROW_COUNT(fill, r30, r31, r32, r33, r34, r35, r36, r37, r38, r39) \
+        + SPARSE_ROW_COUNT(fill, r40, r41, r42, r43, r44, r45, r46, r47, r48, r49), \
+        r50, r51, r52, r53, r54, r55, r56, r57, r58, r59) \
+    } \
+  }
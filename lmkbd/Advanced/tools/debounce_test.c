@@ -0,0 +1,131 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host replay of debounce.c: raw key traces in, reported presses and releases
+ * checked against their expected times.
+ *
+ * Build:  cc -std=c11 -Wall -DDEBOUNCE=5 -Ihost -o debounce_test debounce_test.c ../debounce.c
+ * Usage:  debounce_test        (exit status 0 when every check passes)
+ *
+ * The matrix is scanned 4 times per ms, the way QMK calls debounce(): changed
+ * is set when the raw matrix differs from the previous scan.
+ */
+#include <stdio.h>
+#include "quantum.h"
+#include "debounce.h"
+
+#define SCANS_PER_MS 4
+#define END_MS 240
+#define EVENT_MAX 8
+
+uint16_t host_timer_ms;
+
+typedef struct {
+    uint16_t time;
+    bool     pressed;
+} event_t;
+
+typedef struct {
+    const char *name;
+    bool (*closed)(uint16_t ms, uint8_t scan);
+    uint8_t count;
+    event_t expected[EVENT_MAX]; /* latest accepted time of each event */
+    uint8_t slack[EVENT_MAX];    /* [ms] how much earlier it may come */
+} trace_t;
+
+/* Press bouncing for 2 ms at 10, held, release bouncing for 2 ms at 60 */
+static bool bouncing_press(uint16_t ms, uint8_t scan) {
+    if (ms < 10) return false;
+    if (ms < 12) return (scan % 3) != 0;
+    if (ms < 60) return true;
+    if (ms < 62) return (scan % 2) != 0;
+    return false;
+}
+
+/* Release at 30 (reported at 35, locked until 40), pressed again at 37 and held */
+static bool press_in_lockout(uint16_t ms, uint8_t scan) {
+    (void)scan;
+    return (ms >= 10 && ms < 30) || (ms >= 37 && ms < 100);
+}
+
+/* Clean press held for 195 ms */
+static bool held_key(uint16_t ms, uint8_t scan) {
+    (void)scan;
+    return ms >= 5 && ms < 200;
+}
+
+static const trace_t traces[] = {
+    {"bouncing press", bouncing_press, 2, {{10, true}, {67, false}}, {0, 2}},
+    {"press in lockout", press_in_lockout, 4, {{10, true}, {35, false}, {40, true}, {105, false}}, {0, 1, 3, 1}},
+    {"held key", held_key, 2, {{5, true}, {205, false}}, {0, 1}},
+};
+
+#define TRACE_NUM (sizeof(traces) / sizeof(traces[0]))
+
+int main(void) {
+    matrix_row_t raw[1]    = {0};
+    matrix_row_t cooked[1] = {0};
+    event_t      events[TRACE_NUM][EVENT_MAX];
+    uint8_t      counts[TRACE_NUM] = {0};
+    int          failures          = 0;
+
+    debounce_init(1);
+    for (uint16_t ms = 0; ms < END_MS; ms++) {
+        host_timer_ms = ms;
+        for (uint8_t scan = 0; scan < SCANS_PER_MS; scan++) {
+            matrix_row_t next = 0;
+            matrix_row_t before;
+            bool         changed;
+
+            for (uint8_t col = 0; col < TRACE_NUM; col++) {
+                if (traces[col].closed(ms, scan)) {
+                    next |= (matrix_row_t)1 << col;
+                }
+            }
+            changed = next != raw[0];
+            raw[0]  = next;
+            before  = cooked[0];
+            debounce(raw, cooked, 1, changed);
+            for (uint8_t col = 0; col < TRACE_NUM; col++) {
+                const matrix_row_t bit = (matrix_row_t)1 << col;
+
+                if (((before ^ cooked[0]) & bit) && counts[col] < EVENT_MAX) {
+                    events[col][counts[col]].time    = ms;
+                    events[col][counts[col]].pressed = (cooked[0] & bit) != 0;
+                    counts[col]++;
+                }
+            }
+        }
+    }
+
+    for (uint8_t col = 0; col < TRACE_NUM; col++) {
+        const trace_t *t  = &traces[col];
+        bool           ok = counts[col] == t->count;
+
+        for (uint8_t i = 0; ok && i < t->count; i++) {
+            ok = events[col][i].pressed == t->expected[i].pressed && events[col][i].time <= t->expected[i].time &&
+                 events[col][i].time + t->slack[i] >= t->expected[i].time;
+        }
+        printf("%-4s %s:", ok ? "ok" : "FAIL", t->name);
+        for (uint8_t i = 0; i < counts[col]; i++) {
+            printf(" %s@%u", events[col][i].pressed ? "down" : "up", events[col][i].time);
+        }
+        printf("\n");
+        failures += !ok;
+    }
+    return failures != 0;
+}
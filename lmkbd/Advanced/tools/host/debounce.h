@@ -0,0 +1,8 @@
+/* Host stand-in, see quantum.h */
+#pragma once
+#include "quantum.h"
+
+void debounce_init(uint8_t num_rows);
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+bool debounce_active(void);
+void debounce_free(void);
@@ -0,0 +1,3 @@
+/* Host stand-in, see quantum.h */
+#pragma once
+#include "quantum.h"
@@ -0,0 +1,21 @@
+/* Host stand-in for the QMK headers used by the SU120 sources (tools/ only) */
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef MATRIX_ROWS
+#    define MATRIX_ROWS (6 * 2)
+#endif
+#ifndef MATRIX_COLS
+#    define MATRIX_COLS (6 + 8)
+#endif
+
+typedef uint16_t matrix_row_t;
+
+/* Host clock, advanced by the test */
+extern uint16_t host_timer_ms;
+
+static inline uint16_t timer_read(void) { return host_timer_ms; }
+static inline uint16_t timer_elapsed(uint16_t last) { return (uint16_t)(host_timer_ms - last); }
@@ -0,0 +1,23 @@
+/* Host stand-in, see quantum.h: the soft serial interface of split_common/serial.h */
+#pragma once
+#include "quantum.h"
+
+typedef struct _SSTD_t {
+    uint8_t *status;
+    uint8_t  initiator2target_buffer_size;
+    uint8_t *initiator2target_buffer;
+    uint8_t  target2initiator_buffer_size;
+    uint8_t *target2initiator_buffer;
+} SSTD_t;
+
+#define TID_LIMIT(table) (sizeof(table) / sizeof(SSTD_t))
+
+#define TRANSACTION_END 0
+#define TRANSACTION_NO_RESPONSE 0x1
+#define TRANSACTION_DATA_ERROR 0x2
+#define TRANSACTION_TYPE_ERROR 0x4
+#define TRANSACTION_ACCEPTED 0x8
+
+void soft_serial_initiator_init(SSTD_t *sstd_table, int sstd_table_size);
+void soft_serial_target_init(SSTD_t *sstd_table, int sstd_table_size);
+int  soft_serial_transaction(int sstd_index);
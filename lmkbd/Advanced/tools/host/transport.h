@@ -0,0 +1,8 @@
+/* Host stand-in, see quantum.h */
+#pragma once
+#include "quantum.h"
+
+void transport_master_init(void);
+void transport_slave_init(void);
+bool transport_master(matrix_row_t matrix[]);
+void transport_slave(matrix_row_t matrix[]);
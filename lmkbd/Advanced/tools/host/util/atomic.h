@@ -0,0 +1,5 @@
+/* Host stand-in, see quantum.h: no interrupts on the host */
+#pragma once
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_BLOCK(type) for (int atomic_done_ = 0; !atomic_done_; atomic_done_ = 1)
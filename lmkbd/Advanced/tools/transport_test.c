@@ -0,0 +1,216 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host run of both halves of transport.c over a soft serial stand-in that
+ * drops bits and cuts the link.
+ *
+ * Build:  cc -std=c11 -Wall -DSU120_TRANSPORT_COLS=10 -DSU120_TRANSPORT_CHANGES_ONLY -DSU120_LINK_DOWN_SCANS=3 -Ihost
+ *            -o transport_test transport_test.c ../transport.c
+ * Usage:  transport_test       (exit status 0 when every check passes)
+ *
+ * Both halves live in one process, so each half keeps its own copy of the
+ * transaction buffers, swapped in around transport_slave(): only a
+ * transaction brings the slave data across to the master.  A dropped bit
+ * flips one bit of the received bytes and fails the transaction, as the
+ * soft serial checksum does; a cut answers nothing.
+ *
+ * Every scan checks the master's view of the slave rows: equal to the slave
+ * after a scan without errors, all released while the link is down, and
+ * unchanged after a glitch.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "quantum.h"
+#include "serial.h"
+#include "transport.h"
+#include "../v1.h"
+
+#define ROWS 6
+#define TID_MATRIX 0 /* GET_SLAVE_MATRIX of transport.c */
+#define TID_MAX 4
+#define BUFFER_MAX 16
+
+uint16_t host_timer_ms;
+
+static SSTD_t *table;
+static int     table_size;
+static uint8_t slave_image[TID_MAX][BUFFER_MAX];  /* buffers in the slave's SRAM */
+static uint8_t master_image[TID_MAX][BUFFER_MAX]; /* and in the master's */
+
+/* Wire */
+static bool     cut;
+static unsigned error_permille;
+static unsigned transactions[TID_MAX];
+static unsigned failed_transactions;
+
+/* Both matrices and the checks */
+static matrix_row_t slave_rows[ROWS];
+static matrix_row_t master_rows[ROWS];
+static unsigned     violations;
+
+void soft_serial_initiator_init(SSTD_t *sstd_table, int sstd_table_size) {
+    table      = sstd_table;
+    table_size = sstd_table_size;
+}
+
+void soft_serial_target_init(SSTD_t *sstd_table, int sstd_table_size) {
+    table      = sstd_table;
+    table_size = sstd_table_size;
+}
+
+int soft_serial_transaction(int sstd_index) {
+    const SSTD_t *t = &table[sstd_index];
+
+    transactions[sstd_index]++;
+    if (cut) {
+        failed_transactions++;
+        return TRANSACTION_NO_RESPONSE;
+    }
+    memcpy(t->target2initiator_buffer, slave_image[sstd_index], t->target2initiator_buffer_size);
+    if (t->target2initiator_buffer_size != 0 && (unsigned)(rand() % 1000) < error_permille) {
+        const unsigned bit = (unsigned)rand() % (t->target2initiator_buffer_size * 8u);
+        t->target2initiator_buffer[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+        failed_transactions++;
+        return TRANSACTION_DATA_ERROR;
+    }
+    return TRANSACTION_END;
+}
+
+/* One scan of both halves; returns whether it ran without a failed transaction */
+static bool scan(void) {
+    matrix_row_t before[ROWS];
+    unsigned     failed = failed_transactions;
+    bool         clean;
+
+    host_timer_ms++;
+    for (int tid = 0; tid < table_size; tid++) {
+        memcpy(master_image[tid], table[tid].target2initiator_buffer, table[tid].target2initiator_buffer_size);
+        memcpy(table[tid].target2initiator_buffer, slave_image[tid], table[tid].target2initiator_buffer_size);
+    }
+    transport_slave(slave_rows);
+    for (int tid = 0; tid < table_size; tid++) {
+        memcpy(slave_image[tid], table[tid].target2initiator_buffer, table[tid].target2initiator_buffer_size);
+        memcpy(table[tid].target2initiator_buffer, master_image[tid], table[tid].target2initiator_buffer_size);
+    }
+
+    memcpy(before, master_rows, sizeof(before));
+    transport_master(master_rows);
+    clean = failed_transactions == failed;
+
+    if (clean) {
+        violations += memcmp(master_rows, slave_rows, sizeof(master_rows)) != 0; /* stale or corrupt rows */
+    } else if (!su120_link_up()) {
+        for (int row = 0; row < ROWS; row++) {
+            violations += master_rows[row] != 0; /* lost link: released */
+        }
+    } else {
+        violations += memcmp(master_rows, before, sizeof(master_rows)) != 0; /* glitch: kept */
+    }
+    return clean;
+}
+
+static void key(uint8_t row, uint8_t col, bool pressed) {
+    if (pressed) {
+        slave_rows[row] |= (matrix_row_t)1 << col;
+    } else {
+        slave_rows[row] &= (matrix_row_t)~((matrix_row_t)1 << col);
+    }
+}
+
+static bool pressed(uint8_t row, uint8_t col) { return (master_rows[row] >> col) & 1; }
+
+static int report(const char *name, bool ok) {
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", name);
+    return !ok;
+}
+
+int main(void) {
+    unsigned pulls;
+    bool     ok;
+    int      failures = 0;
+
+    srand(1);
+    transport_master_init();
+    transport_slave_init();
+    for (int i = 0; i < 10; i++) {
+        scan();
+    }
+
+    /* Keys held through a 50 scan cut: one released and one pressed during it */
+    key(0, 0, true);
+    key(2, 9, true);
+    scan();
+    ok  = pressed(0, 0) && pressed(2, 9);
+    cut = true;
+    for (int i = 0; i < 50; i++) {
+        if (i == 20) {
+            key(2, 9, false);
+            key(5, 3, true);
+        }
+        scan();
+        ok = ok && (i < SU120_LINK_DOWN_SCANS - 1 || !su120_link_up());
+    }
+    cut   = false;
+    pulls = transactions[TID_MATRIX];
+    ok    = ok && scan() && su120_link_up() && pressed(0, 0) && !pressed(2, 9) && pressed(5, 3);
+    ok    = ok && transactions[TID_MATRIX] == pulls + 1;
+    failures += report("held keys kept, release and press during a cut reported after it", ok);
+
+    /* Nothing changes during the cut: the sequence did not move, the rows are still pulled once */
+    cut = true;
+    for (int i = 0; i < 10; i++) {
+        scan();
+    }
+    cut   = false;
+    pulls = transactions[TID_MATRIX];
+    ok    = scan() && transactions[TID_MATRIX] == pulls + 1;
+    pulls = transactions[TID_MATRIX];
+    for (int i = 0; i < 10; i++) {
+        ok = ok && scan();
+    }
+    ok = ok && transactions[TID_MATRIX] == pulls && su120_link_stats()->recoveries == 2;
+    failures += report("full pull after a quiet cut, then changes only", ok);
+
+    /* A release during a glitch shorter than SU120_LINK_DOWN_SCANS */
+    cut = true;
+    key(0, 0, false);
+    for (int i = 0; i < SU120_LINK_DOWN_SCANS - 1; i++) {
+        scan();
+    }
+    ok  = su120_link_up() && pressed(0, 0);
+    cut = false;
+    ok  = ok && scan() && !pressed(0, 0);
+    failures += report("release during a glitch kept, then reported", ok);
+
+    /* Random typing over a line dropping bits in 5 % of the transactions, with cuts */
+    error_permille = 50;
+    for (long i = 0; i < 200000; i++) {
+        if (rand() % 20 == 0) {
+            key((uint8_t)(rand() % ROWS), (uint8_t)(rand() % SU120_TRANSPORT_COLS), rand() % 2);
+        }
+        cut = (i % 5000) < 40;
+        scan();
+    }
+    error_permille = 0;
+    ok             = scan() && memcmp(master_rows, slave_rows, sizeof(master_rows)) == 0;
+    printf("     %u failed transactions, link downs %u, recoveries %u\n", failed_transactions, su120_link_stats()->downs,
+           su120_link_stats()->recoveries);
+    failures += report("random bit errors and cuts", ok);
+
+    failures += report("every scan: fresh rows when clean, released when down, kept in a glitch", violations == 0);
+    return failures != 0;
+}
@@ -0,0 +1,262 @@
+/* Copyright 2024 ryhoh/shirosha2
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <util/atomic.h>
+#include "quantum.h"
+#include "matrix.h"
+#include "transport.h"
+#include "serial.h"
+#include "v1.h"
+
+/*
+ * Split transport with a bit-packed slave matrix (SPLIT_TRANSPORT = custom).
+ *
+ * MATRIX_COLS is 6+8, so the generic transport sends each slave row as a
+ * 16-bit matrix_row_t: 12 bytes per scan for the 6 rows.  Here only the
+ * SU120_TRANSPORT_COLS columns a half actually scans are sent, packed back to
+ * back: 60 bits, 8 bytes.
+ *
+ * With SU120_TRANSPORT_CHANGES_ONLY the slave also numbers its matrix, and
+ * the master first reads that one-byte sequence and only pulls the rows when
+ * it moved.  A scan without key changes then costs one byte instead of the
+ * whole matrix.  Soft serial transactions have a fixed size, so the changed
+ * rows are not sent on their own: a change sends the packed matrix.  Any
+ * failed transaction makes the master pull the matrix again, so the
+ * sequence restarting after a slave reset cannot leave stale rows behind.
+ *
+ * The link counts as down after SU120_LINK_DOWN_SCANS failed scans in a row:
+ * the slave keys are released at once and the master keeps polling every
+ * scan.  The first answer after that pulls the whole slave state (rows and
+ * RGB light) before going back to changed-only transfers.  Keys pressed and
+ * released while the link was down cannot be recovered; keys still held are.
+ *
+ * The slave updates its buffers with interrupts off, so the serial ISR never
+ * sends half of an update.  Only the RGBLIGHT_SPLIT sync of the generic
+ * transport is kept; the other optional syncs are not used on SU120.
+ */
+
+#if defined(BACKLIGHT_ENABLE) || defined(ENCODER_ENABLE) || defined(WPM_ENABLE) || defined(SPLIT_MODS_ENABLE)
+#    error "transport.c only syncs the matrix and RGBLIGHT_SPLIT, use the generic split transport"
+#endif
+
+#define ROWS_PER_HAND (MATRIX_ROWS / 2)
+
+#ifndef SU120_LINK_DOWN_SCANS
+#    define SU120_LINK_DOWN_SCANS 3
+#endif
+
+#ifndef SU120_TRANSPORT_COLS
+#    define SU120_TRANSPORT_COLS 10 /* columns read by matrix.c, MATRIX_COL_PINS */
+#endif
+
+#if SU120_TRANSPORT_COLS > 16
+#    error "transport.c: SU120_TRANSPORT_COLS must fit matrix_row_t (<= 16)"
+#endif
+
+#define PACKED_SIZE ((ROWS_PER_HAND * SU120_TRANSPORT_COLS + 7) / 8)
+#define COL_MASK ((matrix_row_t)((1UL << SU120_TRANSPORT_COLS) - 1))
+
+typedef struct {
+    uint8_t rows[PACKED_SIZE];
+    uint8_t sequence;
+} serial_matrix_t;
+
+static volatile serial_matrix_t serial_matrix = {};
+static uint8_t volatile status_matrix = 0;
+
+#ifdef SU120_TRANSPORT_CHANGES_ONLY
+static volatile uint8_t serial_sequence = 0;
+static uint8_t volatile status_sequence = 0;
+#endif
+
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+static volatile rgblight_syncinfo_t serial_rgblight = {};
+static uint8_t volatile status_rgblight = 0;
+#endif
+
+enum serial_transaction_id {
+    GET_SLAVE_MATRIX = 0,
+#ifdef SU120_TRANSPORT_CHANGES_ONLY
+    GET_SLAVE_SEQUENCE,
+#endif
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    PUT_RGBLIGHT,
+#endif
+};
+
+static SSTD_t transactions[] = {
+    [GET_SLAVE_MATRIX] = {(uint8_t *)&status_matrix, 0, NULL, sizeof(serial_matrix), (uint8_t *)&serial_matrix},
+#ifdef SU120_TRANSPORT_CHANGES_ONLY
+    [GET_SLAVE_SEQUENCE] = {(uint8_t *)&status_sequence, 0, NULL, sizeof(serial_sequence), (uint8_t *)&serial_sequence},
+#endif
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    [PUT_RGBLIGHT] = {(uint8_t *)&status_rgblight, sizeof(serial_rgblight), (uint8_t *)&serial_rgblight, 0, NULL},
+#endif
+};
+
+/* Master: slave rows and their sequence, valid until a transaction fails */
+static matrix_row_t       master_rows[ROWS_PER_HAND];
+static uint8_t            applied_sequence;
+static bool               applied_valid;
+static uint8_t            link_errors; /* failed scans in a row, up to SU120_LINK_DOWN_SCANS */
+static uint16_t           link_down_time;
+static su120_link_stats_t link_stats;
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+static bool rgblight_resync;
+#endif
+
+/* Slave: rows last packed */
+static matrix_row_t slave_rows[ROWS_PER_HAND];
+static uint8_t      slave_sequence;
+
+static void pack_rows(uint8_t *packed, const matrix_row_t rows[]) {
+    uint32_t bits  = 0;
+    uint8_t  count = 0;
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        bits |= (uint32_t)(rows[row] & COL_MASK) << count;
+        count += SU120_TRANSPORT_COLS;
+        while (count >= 8) {
+            *packed++ = (uint8_t)bits;
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+    if (count) {
+        *packed = (uint8_t)bits;
+    }
+}
+
+static void unpack_rows(matrix_row_t rows[], const uint8_t *packed) {
+    uint32_t bits  = 0;
+    uint8_t  count = 0;
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        while (count < SU120_TRANSPORT_COLS) {
+            bits |= (uint32_t)(*packed++) << count;
+            count += 8;
+        }
+        rows[row] = (matrix_row_t)bits & COL_MASK;
+        bits >>= SU120_TRANSPORT_COLS;
+        count -= SU120_TRANSPORT_COLS;
+    }
+}
+
+void transport_master_init(void) { soft_serial_initiator_init(transactions, TID_LIMIT(transactions)); }
+
+void transport_slave_init(void) { soft_serial_target_init(transactions, TID_LIMIT(transactions)); }
+
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+static void transport_rgblight_master(void) {
+    if (rgblight_get_change_flags() || rgblight_resync) {
+        rgblight_get_syncinfo((rgblight_syncinfo_t *)&serial_rgblight);
+        if (rgblight_resync) {
+            serial_rgblight.status.change_flags |= RGBLIGHT_STATUS_CHANGE_MODE | RGBLIGHT_STATUS_CHANGE_HSVS | RGBLIGHT_STATUS_CHANGE_TIMER;
+        }
+        if (soft_serial_transaction(PUT_RGBLIGHT) == TRANSACTION_END) {
+            rgblight_clear_change_flags();
+            rgblight_resync = false;
+        }
+    }
+}
+
+static void transport_rgblight_slave(void) {
+    if (status_rgblight == TRANSACTION_ACCEPTED) {
+        rgblight_update_sync((rgblight_syncinfo_t *)&serial_rgblight, false);
+        status_rgblight = TRANSACTION_END;
+    }
+}
+#endif
+
+static bool transport_pull(void) {
+#ifdef SU120_TRANSPORT_CHANGES_ONLY
+    if (soft_serial_transaction(GET_SLAVE_SEQUENCE) != TRANSACTION_END) {
+        return false;
+    }
+    if (applied_valid && serial_sequence == applied_sequence) {
+        return true;
+    }
+#endif
+    if (soft_serial_transaction(GET_SLAVE_MATRIX) != TRANSACTION_END) {
+        return false;
+    }
+    unpack_rows(master_rows, (const uint8_t *)serial_matrix.rows);
+    applied_sequence = serial_matrix.sequence;
+    applied_valid    = true;
+    return true;
+}
+
+bool transport_master(matrix_row_t matrix[]) {
+    bool connected = transport_pull();
+
+    if (connected) {
+        if (link_errors >= SU120_LINK_DOWN_SCANS) {
+            link_stats.recoveries++;
+            link_stats.last_outage_ms = timer_elapsed(link_down_time);
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+            rgblight_resync = true;
+#endif
+        }
+        link_errors = 0;
+    } else {
+        applied_valid = false;
+        if (link_stats.errors < UINT16_MAX) {
+            link_stats.errors++;
+        }
+        if (link_errors < SU120_LINK_DOWN_SCANS && ++link_errors == SU120_LINK_DOWN_SCANS) {
+            link_stats.downs++;
+            link_down_time = timer_read();
+            memset(master_rows, 0, sizeof(master_rows)); /* release the slave keys */
+        }
+    }
+    memcpy(matrix, master_rows, sizeof(master_rows));
+
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    if (connected) {
+        transport_rgblight_master();
+    }
+#endif
+    /* a glitch keeps the last rows, a lost link reports them released */
+    return connected || link_errors >= SU120_LINK_DOWN_SCANS;
+}
+
+bool su120_link_up(void) { return link_errors < SU120_LINK_DOWN_SCANS; }
+
+const su120_link_stats_t *su120_link_stats(void) { return &link_stats; }
+
+void transport_slave(matrix_row_t matrix[]) {
+#if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    transport_rgblight_slave();
+#endif
+
+    if (slave_sequence != 0 && memcmp(slave_rows, matrix, sizeof(slave_rows)) == 0) {
+        return;
+    }
+    memcpy(slave_rows, matrix, sizeof(slave_rows));
+    if (++slave_sequence == 0) {
+        slave_sequence = 1; /* 0: nothing packed yet */
+    }
+
+    uint8_t packed[PACKED_SIZE];
+    pack_rows(packed, slave_rows);
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        memcpy((uint8_t *)serial_matrix.rows, packed, PACKED_SIZE);
+        serial_matrix.sequence = slave_sequence;
+#ifdef SU120_TRANSPORT_CHANGES_ONLY
+        serial_sequence = slave_sequence;
+#endif
+    }
+}
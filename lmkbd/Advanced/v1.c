@@ -13,12 +13,78 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include "rev1.h"
+#include "v1.h"
+#include "send_string_queue.h"
+#ifdef VIA_ENABLE
+#  include "via.h"
+#endif
 
 // Optional override functions below.
 // You can leave any or all of these undefined.
 // These are only required if you want to perform custom actions.
 
+void matrix_scan_kb(void) {
+#ifdef NKRO_ENABLE
+  // send the NKRO report collected during the previous scan (report_coalesce.c)
+  su120_report_coalesce_task();
+#endif
+  // play queued SEND_STRING_ASYNC() macros, one report per millisecond
+  send_string_queue_task();
+
+  matrix_scan_user();
+}
+
+#ifdef VIA_ENABLE
+#  ifdef SU120_CHATTER_STATS
+// Chatter counters over VIA's raw HID channel, rows of the half on USB only.
+//   request:  SU120_CMD_CHATTER, row (0xFF clears the counters)
+//   response: SU120_CMD_CHATTER, row, DEBOUNCE, shortest gap [ms] (255: none),
+//             one 4-bit count per column, low nibble first
+static void su120_via_chatter(uint8_t *data) {
+  const uint8_t row = data[1];
+
+  if (row == 0xFF) {
+    su120_chatter_clear();
+    return;
+  }
+  data[2] = DEBOUNCE;
+  data[3] = su120_chatter_min_gap();
+  for (uint8_t col = 0; col < (MATRIX_COLS); col += 2) {
+    data[4 + col / 2] = su120_chatter_count(row, col) | (su120_chatter_count(row, col + 1) << 4);
+  }
+}
+#  endif
+
+// Split link counters (transport.c).
+//   request:  SU120_CMD_LINK
+//   response: SU120_CMD_LINK, link up (0/1), then downs, recoveries, failed
+//             scans, last outage [ms] as 16-bit little endian values
+static void su120_via_link(uint8_t *data) {
+  const su120_link_stats_t *stats = su120_link_stats();
+  const uint16_t values[] = {stats->downs, stats->recoveries, stats->errors, stats->last_outage_ms};
+
+  data[1] = su120_link_up();
+  for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    data[2 + i * 2] = (uint8_t)values[i];
+    data[3 + i * 2] = (uint8_t)(values[i] >> 8);
+  }
+}
+
+void raw_hid_receive_kb(uint8_t *data, uint8_t length) {
+#  ifdef SU120_CHATTER_STATS
+  if (data[0] == SU120_CMD_CHATTER && length >= 4 + (MATRIX_COLS + 1) / 2) {
+    su120_via_chatter(data);
+    return;
+  }
+#  endif
+  if (data[0] == SU120_CMD_LINK && length >= 10) {
+    su120_via_link(data);
+    return;
+  }
+  data[0] = id_unhandled;
+}
+#endif
+
 /*
 
 void matrix_init_kb(void) {
@@ -28,13 +94,6 @@ void matrix_init_kb(void) {
   matrix_init_user();
 }
 
-void matrix_scan_kb(void) {
-  // put your looping keyboard code here
-  // runs every cycle (a lot)
-
-  matrix_scan_user();
-}
-
 bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
   // put your per-action keyboard code here
   // runs for every action, just before processing by the firmware
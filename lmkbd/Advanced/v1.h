@@ -55,3 +55,39 @@
     { r50, r51, r52, r53, r54, r55, r56, r57, r58, r59 } \
   }
 
+#ifdef SU120_MATRIX_MEASURE_CYCLES
+/* CPU cycles spent in the last / slowest matrix scan (matrix.c) */
+uint16_t su120_matrix_scan_cycles(void);
+uint16_t su120_matrix_scan_cycles_max(void);
+#endif
+
+#ifdef NKRO_ENABLE
+/* NKRO report coalescing (report_coalesce.c) */
+void     su120_report_coalesce_task(void);
+uint16_t su120_reports_sent(void);
+uint16_t su120_reports_coalesced(void);
+#endif
+
+#ifdef SU120_CHATTER_STATS
+/* Chatter counters of the local half (debounce.c) */
+uint8_t su120_chatter_count(uint8_t row, uint8_t col); /* 0..15, saturating */
+uint8_t su120_chatter_min_gap(void);                   /* [ms], 255 if none seen */
+void    su120_chatter_clear(void);
+
+/* VIA raw HID command reading them (v1.c) */
+#    define SU120_CMD_CHATTER 0xC0
+#endif
+
+/* Split link of the master (transport.c) */
+typedef struct {
+    uint16_t downs;          /* SU120_LINK_DOWN_SCANS failed scans in a row */
+    uint16_t recoveries;     /* link back, slave state pulled in full */
+    uint16_t errors;         /* failed scans, saturating */
+    uint16_t last_outage_ms; /* length of the last outage */
+} su120_link_stats_t;
+
+bool                      su120_link_up(void);
+const su120_link_stats_t *su120_link_stats(void);
+
+/* VIA raw HID command reading them (v1.c) */
+#define SU120_CMD_LINK 0xC1